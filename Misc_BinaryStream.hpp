@@ -0,0 +1,57 @@
+/*
+ * Misc_BinaryStream.hpp
+ *
+ * Revision: October 2026
+ *
+ * Reading and writing raw values on binary streams.
+ */
+
+#ifndef MISC_BINARYSTREAM_HPP_
+#define MISC_BINARYSTREAM_HPP_
+
+// Standard libraries
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+// Writes the bytes of a trivially copyable value in native byte order.
+template<typename T>
+inline void writeBinary(std::ostream& output, const T& value){
+  static_assert(std::is_trivially_copyable<T>::value, "writeBinary() needs a trivially copyable type");
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Reads a value written by writeBinary(). Returns false if the stream ended or failed.
+template<typename T>
+inline bool readBinary(std::istream& input, T& value){
+  static_assert(std::is_trivially_copyable<T>::value, "readBinary() needs a trivially copyable type");
+  input.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return bool(input);
+}
+
+// Writes a vector of indices as a 64-bit count followed by one 64-bit integer per index.
+template<typename Index_t>
+inline void writeIndices(std::ostream& output, const std::vector<Index_t>& indices){
+  writeBinary(output, uint64_t(indices.size()));
+  for(size_t i = 0; i < indices.size(); i++){
+    writeBinary(output, uint64_t(indices[i]));
+  }
+}
+
+// Reads indices written by writeIndices(), each of which must be below the indicated bound.
+// Returns false if the stream ended or an index is out of bounds.
+template<typename Index_t>
+inline bool readIndices(std::istream& input, std::vector<Index_t>& indices, uint64_t bound){
+  uint64_t size;
+  if(!readBinary(input, size)) return false;
+  indices.clear();
+  for(uint64_t i = 0; i < size; i++){
+    uint64_t index;
+    if(!readBinary(input, index) || index >= bound) return false;
+    indices.push_back(Index_t(index));
+  }
+  return true;
+}
+
+#endif /* MISC_BINARYSTREAM_HPP_ */
@@ -0,0 +1,217 @@
+/*
+ * Misc_CopyOnWrite.hpp
+ *
+ * Revision: October 2026
+ *
+ * Reference-counted storage that is shared between copies and copied lazily on the first write.
+ */
+
+#ifndef MISC_COPYONWRITE_HPP_
+#define MISC_COPYONWRITE_HPP_
+
+// Standard libraries
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// An object shared by all copies of the pointer until one of them writes to it.
+// Reading goes through operator* and operator->, which only give const access; write() first copies the object
+// if another pointer still shares it. The reference count is kept next to the object, so checking for sharing
+// is a single load. Copies may be read and written from different threads, but a single pointer must not be
+// written while it is used elsewhere.
+template<typename T>
+class CowPointer{
+  public:
+    // Constructor. Owns a default-constructed object.
+    CowPointer():
+      _holder(new Holder()){
+    }
+
+    // Constructor. Owns a copy of the supplied object.
+    explicit CowPointer(const T& value):
+      _holder(new Holder(value)){
+    }
+
+    // Constructor. Shares the object of the supplied pointer.
+    CowPointer(const CowPointer& other):
+      _holder(other._holder){
+      _holder->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Constructor. Takes over the object of the supplied pointer, which may then only be assigned or destroyed.
+    CowPointer(CowPointer&& other) noexcept:
+      _holder(other._holder){
+      other._holder = 0;
+    }
+
+    // Destructor. Deletes the object if no other pointer shares it.
+    ~CowPointer(){
+      this->release();
+    }
+
+    // Shares the object of the supplied pointer.
+    CowPointer& operator=(const CowPointer& other){
+      other._holder->references.fetch_add(1, std::memory_order_relaxed);
+      this->release();
+      _holder = other._holder;
+      return *this;
+    }
+
+    // Takes over the object of the supplied pointer.
+    CowPointer& operator=(CowPointer&& other) noexcept{
+      if(this != &other){
+        this->release();
+        _holder = other._holder;
+        other._holder = 0;
+      }
+      return *this;
+    }
+
+    // Returns the object for reading.
+    const T& operator*() const{
+      return _holder->value;
+    }
+
+    // Returns the object for reading.
+    const T* operator->() const{
+      return &_holder->value;
+    }
+
+    // Returns the object for writing, copying it first if it is shared.
+    T& write(){
+      if(this->isShared()) this->detach();
+      return _holder->value;
+    }
+
+    // Returns true if another pointer shares the object.
+    // The acquire load orders the writes that follow after the reads of owners that released the object.
+    bool isShared() const{
+      return _holder->references.load(std::memory_order_acquire) > 1;
+    }
+
+  protected:
+    // The object and the number of pointers sharing it.
+    struct Holder{
+      Holder():
+        value(),
+        references(1){
+      }
+
+      explicit Holder(const T& object):
+        value(object),
+        references(1){
+      }
+
+      T value;
+      std::atomic<size_t> references;
+    };
+
+    // Replaces the shared object by a copy owned by this pointer alone.
+    void detach(){
+      Holder* holder = new Holder(_holder->value);
+      this->release();
+      _holder = holder;
+    }
+
+    // Drops the reference of this pointer, deleting the object if it was the last one.
+    void release(){
+      if(_holder && _holder->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete _holder;
+      _holder = 0;
+    }
+
+    Holder* _holder;
+};
+
+// A vector stored in chunks of chunkSize elements that are shared between copies.
+// Copying the vector copies one pointer per chunk; writing an element through write() copies only its chunk,
+// if it is shared. Elements are read through the const operator[], which never copies.
+template<typename T>
+class CowVector{
+  public:
+    typedef T value_type;
+
+    // Number of elements per chunk (a power of two).
+    static constexpr size_t chunkBits = 10;
+    static constexpr size_t chunkSize = size_t(1) << chunkBits;
+
+    // Constructor. Creates an empty vector.
+    CowVector():
+      _size(0){
+    }
+
+    // Returns the number of elements.
+    size_t size() const{
+      return _size;
+    }
+
+    // Returns true if the vector holds no elements.
+    bool empty() const{
+      return _size == 0;
+    }
+
+    // Returns the indicated element for reading.
+    const T& operator[](size_t index) const{
+      return (*_chunks[index >> chunkBits])[index & (chunkSize - 1)];
+    }
+
+    // Returns the indicated element for writing, copying its chunk first if it is shared.
+    T& write(size_t index){
+      return _chunks[index >> chunkBits].write()[index & (chunkSize - 1)];
+    }
+
+    // Appends an element.
+    void push_back(const T& value){
+      if((_size & (chunkSize - 1)) == 0){
+        _chunks.push_back(CowPointer<chunk_t>());
+        _chunks.back().write().reserve(chunkSize);
+      }
+      _chunks.back().write().push_back(value);
+      _size++;
+    }
+
+    // Removes the elements from the indicated position on.
+    void truncate(size_t size){
+      if(size >= _size) return;
+      _chunks.erase(_chunks.begin() + ((size + chunkSize - 1) >> chunkBits), _chunks.end());
+      if(size & (chunkSize - 1)){
+        chunk_t& chunk = _chunks.back().write();
+        chunk.erase(chunk.begin() + (size & (chunkSize - 1)), chunk.end());
+      }
+      _size = size;
+    }
+
+    // Removes all elements.
+    void clear(){
+      _chunks.clear();
+      _size = 0;
+    }
+
+    // Reserves room for the chunk pointers of the indicated number of elements.
+    void reserve(size_t size){
+      _chunks.reserve((size + chunkSize - 1) >> chunkBits);
+    }
+
+    // Exchanges the contents of two vectors.
+    void swap(CowVector& other){
+      _chunks.swap(other._chunks);
+      std::swap(_size, other._size);
+    }
+
+    // Returns the number of chunks shared with other vectors.
+    size_t getNbOfSharedChunks() const{
+      size_t nbOfShared = 0;
+      for(size_t i = 0; i < _chunks.size(); i++){
+        if(_chunks[i].isShared()) nbOfShared++;
+      }
+      return nbOfShared;
+    }
+
+  protected:
+    typedef std::vector<T> chunk_t;
+
+    std::vector<CowPointer<chunk_t> > _chunks;
+    size_t _size;
+};
+
+#endif /* MISC_COPYONWRITE_HPP_ */
@@ -0,0 +1,347 @@
+/*
+ * Misc_FastMath.hpp
+ *
+ * Revision: October 2026
+ *
+ * Approximations of exp, sin and tanh by polynomials and by interpolation tables.
+ *
+ * The polynomial versions are branch-free. Compilers do not vectorize loops over them on their own (the range clamps
+ * and reflections keep them from if-converting without -fno-trapping-math), so vectorExp(), vectorSin() and
+ * vectorTanh() apply the same operations to a whole AVX2 or SSE2 register and match the scalar versions lane by lane.
+ * Their maximum errors in double precision are about:
+ * - exp: 1e-14 relative, for x in [-708, 708]; arguments outside are clamped
+ * - sin: 6e-12 absolute, for |x| < 1e6
+ * - tanh: 5e-15 absolute
+ * In single precision all three stay within 2.5e-7 (exp relative, for x in [-87, 88]; sin for |x| < 1e4).
+ * The interpolation tables hold double values and interpolate linearly between 8193 points; their maximum
+ * absolute errors are about 6e-7 for tanh, 8e-8 for sin and 8e-7 for the scaled Gaussian of the activation functions.
+ */
+
+#ifndef MISC_FASTMATH_HPP_
+#define MISC_FASTMATH_HPP_
+
+// Standard libraries
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Constants of the polynomial approximations for each floating-point type.
+template<typename Scalar_t>
+struct FastMathTraits;
+
+template<>
+struct FastMathTraits<double>{
+  typedef uint64_t bits_t;
+  static constexpr int mantissaBits = 52;
+  static constexpr bits_t exponentBias = 1023;
+  // Adding and subtracting 1.5 * 2^52 rounds a double to the nearest integer.
+  static constexpr double shifter = 6755399441055744.0;
+  static constexpr double minExpArgument = -708.0;
+  static constexpr double maxExpArgument = 708.0;
+  // ln(2) and 2*pi split into a high part with trailing zero bits and a low part (Cody-Waite reduction).
+  static constexpr double ln2High = 6.93147180369123816490e-01;
+  static constexpr double ln2Low = 1.90821492927058770002e-10;
+  static constexpr double twoPiHigh = 6.28318530717958623200e+00;
+  static constexpr double twoPiLow = 2.44929359829470635445e-16;
+  static constexpr double piHigh = 3.14159265358979311600e+00;
+  static constexpr double piLow = 1.22464679914735317723e-16;
+};
+
+template<>
+struct FastMathTraits<float>{
+  typedef uint32_t bits_t;
+  static constexpr int mantissaBits = 23;
+  static constexpr bits_t exponentBias = 127;
+  // Adding and subtracting 1.5 * 2^23 rounds a float to the nearest integer.
+  static constexpr float shifter = 12582912.0f;
+  static constexpr float minExpArgument = -87.0f;
+  static constexpr float maxExpArgument = 88.0f;
+  static constexpr float ln2High = 0.693359375f;
+  static constexpr float ln2Low = -2.12194440e-4f;
+  static constexpr float twoPiHigh = 6.28125f;
+  static constexpr float twoPiLow = 1.9353071795864769e-3f;
+  static constexpr float piHigh = 3.140625f;
+  static constexpr float piLow = 9.67653589793116e-4f;
+};
+
+#if defined(__AVX2__) || defined(__SSE2__)
+// Operations on the widest vector of each floating-point type that the compiler targets.
+template<typename Scalar_t>
+struct VectorOps;
+
+#if defined(__AVX2__)
+template<>
+struct VectorOps<double>{
+  typedef __m256d vector_t;
+  static constexpr size_t lanes = 4;
+  static vector_t load(const double* p){ return _mm256_loadu_pd(p); }
+  static void store(double* p, vector_t x){ _mm256_storeu_pd(p, x); }
+  static vector_t set(double x){ return _mm256_set1_pd(x); }
+  static vector_t add(vector_t a, vector_t b){ return _mm256_add_pd(a, b); }
+  static vector_t sub(vector_t a, vector_t b){ return _mm256_sub_pd(a, b); }
+  static vector_t mul(vector_t a, vector_t b){ return _mm256_mul_pd(a, b); }
+  static vector_t div(vector_t a, vector_t b){ return _mm256_div_pd(a, b); }
+  static vector_t negate(vector_t x){ return _mm256_xor_pd(x, _mm256_set1_pd(-0.0)); }
+  // min() and max() return b where either argument is NaN.
+  static vector_t min(vector_t a, vector_t b){ return _mm256_min_pd(a, b); }
+  static vector_t max(vector_t a, vector_t b){ return _mm256_max_pd(a, b); }
+  static vector_t greater(vector_t a, vector_t b){ return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+  static vector_t less(vector_t a, vector_t b){ return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  static vector_t select(vector_t mask, vector_t a, vector_t b){ return _mm256_blendv_pd(b, a, mask); }
+  // Adds the exponent bias to the integer in the low bits of every lane and moves it into the exponent field.
+  static vector_t exponent(vector_t x){
+    __m256i bits = _mm256_add_epi64(_mm256_castpd_si256(x), _mm256_set1_epi64x(1023));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+  }
+};
+
+template<>
+struct VectorOps<float>{
+  typedef __m256 vector_t;
+  static constexpr size_t lanes = 8;
+  static vector_t load(const float* p){ return _mm256_loadu_ps(p); }
+  static void store(float* p, vector_t x){ _mm256_storeu_ps(p, x); }
+  static vector_t set(float x){ return _mm256_set1_ps(x); }
+  static vector_t add(vector_t a, vector_t b){ return _mm256_add_ps(a, b); }
+  static vector_t sub(vector_t a, vector_t b){ return _mm256_sub_ps(a, b); }
+  static vector_t mul(vector_t a, vector_t b){ return _mm256_mul_ps(a, b); }
+  static vector_t div(vector_t a, vector_t b){ return _mm256_div_ps(a, b); }
+  static vector_t negate(vector_t x){ return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f)); }
+  static vector_t min(vector_t a, vector_t b){ return _mm256_min_ps(a, b); }
+  static vector_t max(vector_t a, vector_t b){ return _mm256_max_ps(a, b); }
+  static vector_t greater(vector_t a, vector_t b){ return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static vector_t less(vector_t a, vector_t b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static vector_t select(vector_t mask, vector_t a, vector_t b){ return _mm256_blendv_ps(b, a, mask); }
+  static vector_t exponent(vector_t x){
+    __m256i bits = _mm256_add_epi32(_mm256_castps_si256(x), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 23));
+  }
+};
+#else
+template<>
+struct VectorOps<double>{
+  typedef __m128d vector_t;
+  static constexpr size_t lanes = 2;
+  static vector_t load(const double* p){ return _mm_loadu_pd(p); }
+  static void store(double* p, vector_t x){ _mm_storeu_pd(p, x); }
+  static vector_t set(double x){ return _mm_set1_pd(x); }
+  static vector_t add(vector_t a, vector_t b){ return _mm_add_pd(a, b); }
+  static vector_t sub(vector_t a, vector_t b){ return _mm_sub_pd(a, b); }
+  static vector_t mul(vector_t a, vector_t b){ return _mm_mul_pd(a, b); }
+  static vector_t div(vector_t a, vector_t b){ return _mm_div_pd(a, b); }
+  static vector_t negate(vector_t x){ return _mm_xor_pd(x, _mm_set1_pd(-0.0)); }
+  // min() and max() return b where either argument is NaN.
+  static vector_t min(vector_t a, vector_t b){ return _mm_min_pd(a, b); }
+  static vector_t max(vector_t a, vector_t b){ return _mm_max_pd(a, b); }
+  static vector_t greater(vector_t a, vector_t b){ return _mm_cmpgt_pd(a, b); }
+  static vector_t less(vector_t a, vector_t b){ return _mm_cmplt_pd(a, b); }
+  static vector_t select(vector_t mask, vector_t a, vector_t b){ return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+  // Adds the exponent bias to the integer in the low bits of every lane and moves it into the exponent field.
+  static vector_t exponent(vector_t x){
+    __m128i bits = _mm_add_epi64(_mm_castpd_si128(x), _mm_set1_epi64x(1023));
+    return _mm_castsi128_pd(_mm_slli_epi64(bits, 52));
+  }
+};
+
+template<>
+struct VectorOps<float>{
+  typedef __m128 vector_t;
+  static constexpr size_t lanes = 4;
+  static vector_t load(const float* p){ return _mm_loadu_ps(p); }
+  static void store(float* p, vector_t x){ _mm_storeu_ps(p, x); }
+  static vector_t set(float x){ return _mm_set1_ps(x); }
+  static vector_t add(vector_t a, vector_t b){ return _mm_add_ps(a, b); }
+  static vector_t sub(vector_t a, vector_t b){ return _mm_sub_ps(a, b); }
+  static vector_t mul(vector_t a, vector_t b){ return _mm_mul_ps(a, b); }
+  static vector_t div(vector_t a, vector_t b){ return _mm_div_ps(a, b); }
+  static vector_t negate(vector_t x){ return _mm_xor_ps(x, _mm_set1_ps(-0.0f)); }
+  static vector_t min(vector_t a, vector_t b){ return _mm_min_ps(a, b); }
+  static vector_t max(vector_t a, vector_t b){ return _mm_max_ps(a, b); }
+  static vector_t greater(vector_t a, vector_t b){ return _mm_cmpgt_ps(a, b); }
+  static vector_t less(vector_t a, vector_t b){ return _mm_cmplt_ps(a, b); }
+  static vector_t select(vector_t mask, vector_t a, vector_t b){ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+  static vector_t exponent(vector_t x){
+    __m128i bits = _mm_add_epi32(_mm_castps_si128(x), _mm_set1_epi32(127));
+    return _mm_castsi128_ps(_mm_slli_epi32(bits, 23));
+  }
+};
+#endif
+#endif
+
+// Polynomial approximations of elementary functions for float and double.
+class FastMath{
+  public:
+    // Returns e^x. Arguments beyond the range of normal numbers are clamped; NaN is passed through.
+    template<typename Scalar_t>
+    static Scalar_t exp(Scalar_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      typedef typename traits::bits_t bits_t;
+      x = x < traits::minExpArgument ? traits::minExpArgument : x;
+      x = x > traits::maxExpArgument ? traits::maxExpArgument : x;
+      // x = k*ln(2) + r with k integer and |r| <= ln(2)/2, so that e^x = 2^k * e^r.
+      Scalar_t shifted = x * Scalar_t(log2e) + traits::shifter;
+      Scalar_t k = shifted - traits::shifter;
+      Scalar_t r = (x - k * traits::ln2High) - k * traits::ln2Low;
+      Scalar_t p = Scalar_t(expCoefficients[0]);
+      for(int i = 1; i < 12; i++){
+        p = p * r + Scalar_t(expCoefficients[i]);
+      }
+      // The low bits of shifted hold k; moving k + bias into the exponent field gives 2^k.
+      bits_t bits;
+      std::memcpy(&bits, &shifted, sizeof(bits));
+      bits = (bits + traits::exponentBias) << traits::mantissaBits;
+      Scalar_t scale;
+      std::memcpy(&scale, &bits, sizeof(scale));
+      return p * scale;
+    }
+
+    // Returns sin(x).
+    template<typename Scalar_t>
+    static Scalar_t sin(Scalar_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      Scalar_t r = reduce(x);
+      // Reflects r into [-pi/2, pi/2], using sin(pi - r) = sin(r).
+      r = r > Scalar_t(halfPi) ? (traits::piHigh - r) + traits::piLow : r;
+      r = r < Scalar_t(-halfPi) ? (-traits::piHigh - r) - traits::piLow : r;
+      Scalar_t r2 = r * r;
+      Scalar_t p = Scalar_t(sinCoefficients[0]);
+      for(int i = 1; i < 8; i++){
+        p = p * r2 + Scalar_t(sinCoefficients[i]);
+      }
+      return p * r;
+    }
+
+    // Returns tanh(x), computed as 1 - 2 / (e^2x + 1).
+    template<typename Scalar_t>
+    static Scalar_t tanh(Scalar_t x){
+      Scalar_t e = FastMath::exp(x + x);
+      return Scalar_t(1) - Scalar_t(2) / (e + Scalar_t(1));
+    }
+
+    // Returns x - k*2*pi for the integer k that brings the result into [-pi, pi].
+    template<typename Scalar_t>
+    static Scalar_t reduce(Scalar_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      Scalar_t k = (x * Scalar_t(inverseTwoPi) + traits::shifter) - traits::shifter;
+      return (x - k * traits::twoPiHigh) - k * traits::twoPiLow;
+    }
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Returns exp() of every lane of x.
+    template<typename Scalar_t>
+    static typename VectorOps<Scalar_t>::vector_t vectorExp(typename VectorOps<Scalar_t>::vector_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      typedef VectorOps<Scalar_t> ops;
+      typedef typename ops::vector_t vector_t;
+      // NaN lanes are passed through, since max() and min() return their second argument for them.
+      x = ops::max(ops::set(traits::minExpArgument), x);
+      x = ops::min(ops::set(traits::maxExpArgument), x);
+      vector_t shifted = ops::add(ops::mul(x, ops::set(Scalar_t(log2e))), ops::set(traits::shifter));
+      vector_t k = ops::sub(shifted, ops::set(traits::shifter));
+      vector_t r = ops::sub(ops::sub(x, ops::mul(k, ops::set(traits::ln2High))), ops::mul(k, ops::set(traits::ln2Low)));
+      vector_t p = ops::set(Scalar_t(expCoefficients[0]));
+      for(int i = 1; i < 12; i++){
+        p = ops::add(ops::mul(p, r), ops::set(Scalar_t(expCoefficients[i])));
+      }
+      return ops::mul(p, ops::exponent(shifted));
+    }
+
+    // Returns sin() of every lane of x.
+    template<typename Scalar_t>
+    static typename VectorOps<Scalar_t>::vector_t vectorSin(typename VectorOps<Scalar_t>::vector_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      typedef VectorOps<Scalar_t> ops;
+      typedef typename ops::vector_t vector_t;
+      vector_t r = vectorReduce<Scalar_t>(x);
+      vector_t above = ops::add(ops::sub(ops::set(traits::piHigh), r), ops::set(traits::piLow));
+      r = ops::select(ops::greater(r, ops::set(Scalar_t(halfPi))), above, r);
+      vector_t below = ops::sub(ops::sub(ops::set(-traits::piHigh), r), ops::set(traits::piLow));
+      r = ops::select(ops::less(r, ops::set(Scalar_t(-halfPi))), below, r);
+      vector_t r2 = ops::mul(r, r);
+      vector_t p = ops::set(Scalar_t(sinCoefficients[0]));
+      for(int i = 1; i < 8; i++){
+        p = ops::add(ops::mul(p, r2), ops::set(Scalar_t(sinCoefficients[i])));
+      }
+      return ops::mul(p, r);
+    }
+
+    // Returns tanh() of every lane of x.
+    template<typename Scalar_t>
+    static typename VectorOps<Scalar_t>::vector_t vectorTanh(typename VectorOps<Scalar_t>::vector_t x){
+      typedef VectorOps<Scalar_t> ops;
+      typename ops::vector_t e = vectorExp<Scalar_t>(ops::add(x, x));
+      return ops::sub(ops::set(Scalar_t(1)), ops::div(ops::set(Scalar_t(2)), ops::add(e, ops::set(Scalar_t(1)))));
+    }
+
+    // Returns reduce() of every lane of x.
+    template<typename Scalar_t>
+    static typename VectorOps<Scalar_t>::vector_t vectorReduce(typename VectorOps<Scalar_t>::vector_t x){
+      typedef FastMathTraits<Scalar_t> traits;
+      typedef VectorOps<Scalar_t> ops;
+      typename ops::vector_t shifter = ops::set(traits::shifter);
+      typename ops::vector_t k = ops::sub(ops::add(ops::mul(x, ops::set(Scalar_t(inverseTwoPi))), shifter), shifter);
+      return ops::sub(ops::sub(x, ops::mul(k, ops::set(traits::twoPiHigh))), ops::mul(k, ops::set(traits::twoPiLow)));
+    }
+#endif
+
+  protected:
+    static constexpr double log2e = 1.44269504088896340736;
+    static constexpr double inverseTwoPi = 0.15915494309189533577;
+    static constexpr double halfPi = 1.57079632679489661923;
+
+    // Taylor polynomial of degree 11 for e^r, highest coefficient first.
+    static constexpr double expCoefficients[12] = {
+      1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+      1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0
+    };
+
+    // Taylor polynomial of degree 15 for sin(r), in powers of r*r, highest coefficient first.
+    static constexpr double sinCoefficients[8] = {
+      -1.0 / 1307674368000.0, 1.0 / 6227020800.0, -1.0 / 39916800.0, 1.0 / 362880.0,
+      -1.0 / 5040.0, 1.0 / 120.0, -1.0 / 6.0, 1.0
+    };
+};
+
+// A function sampled at evenly spaced points and interpolated linearly between them.
+// Arguments outside the sampled range get the value at the nearest end; NaN is passed through.
+class InterpolationTable{
+  public:
+    // Constructor. Samples the supplied function at size + 1 points spanning [min, max].
+    template<typename Function>
+    InterpolationTable(double min, double max, size_t size, Function function):
+      _min(min),
+      _scale(size / (max - min)),
+      _size(size){
+      _values.resize(size + 2);
+      for(size_t i = 0; i <= size; i++){
+        _values[i] = function(min + (max - min) * double(i) / double(size));
+      }
+      // Repeats the last point so that the right end interpolates within bounds.
+      _values[size + 1] = _values[size];
+    }
+
+    // Returns the interpolated value of the function at x.
+    double evaluate(double x) const{
+      double t = (x - _min) * _scale;
+      t = t > 0.0 ? t : 0.0;
+      t = t < double(_size) ? t : double(_size);
+      size_t i = size_t(t);
+      double fraction = t - double(i);
+      double result = _values[i] + (_values[i + 1] - _values[i]) * fraction;
+      return x != x ? x : result;
+    }
+
+  protected:
+    double _min;
+    double _scale;
+    size_t _size;
+    std::vector<double> _values;
+};
+
+#endif /* MISC_FASTMATH_HPP_ */
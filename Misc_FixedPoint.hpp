@@ -0,0 +1,147 @@
+/*
+ * Misc_FixedPoint.hpp
+ *
+ * Revision: October 2026
+ *
+ * A saturating fixed-point number type for networks run on hardware without a floating-point unit.
+ */
+
+#ifndef MISC_FIXEDPOINT_HPP_
+#define MISC_FIXEDPOINT_HPP_
+
+// Standard libraries
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+// A signed fixed-point number stored in Integer_t with FractionBits fractional bits.
+// Results that do not fit are saturated to the representable range; conversions from double are rounded to nearest.
+template<typename Integer_t, int FractionBits>
+class FixedPoint{
+  public:
+    typedef Integer_t integer_t;
+
+    // Number of fractional bits.
+    static constexpr int fractionBits = FractionBits;
+
+    // Constructor. Creates zero.
+    FixedPoint():
+      _raw(0){
+    }
+
+    // Constructor. Converts the supplied value, saturating it to the representable range.
+    FixedPoint(double value):
+      _raw(fromDouble(value)){
+    }
+
+    // Returns the number with the indicated raw representation.
+    static FixedPoint fromRaw(Integer_t raw){
+      FixedPoint number;
+      number._raw = raw;
+      return number;
+    }
+
+    // Returns the raw representation of this number.
+    Integer_t getRaw() const{
+      return _raw;
+    }
+
+    // Converts this number to double.
+    explicit operator double() const{
+      return double(_raw) / double(wide_t(1) << FractionBits);
+    }
+
+    // Arithmetic operators.
+    FixedPoint operator+(FixedPoint other) const{
+      return fromRaw(saturate(wide_t(_raw) + wide_t(other._raw)));
+    }
+
+    FixedPoint operator-(FixedPoint other) const{
+      return fromRaw(saturate(wide_t(_raw) - wide_t(other._raw)));
+    }
+
+    FixedPoint operator-() const{
+      return fromRaw(saturate(-wide_t(_raw)));
+    }
+
+    FixedPoint operator*(FixedPoint other) const{
+      wide_t product = wide_t(_raw) * wide_t(other._raw);
+      return fromRaw(saturate((product + (wide_t(1) << (FractionBits - 1))) >> FractionBits));
+    }
+
+    FixedPoint operator/(FixedPoint other) const{
+      if(other._raw == 0) return fromRaw(_raw < 0 ? std::numeric_limits<Integer_t>::min() : std::numeric_limits<Integer_t>::max());
+      return fromRaw(saturate((wide_t(_raw) << FractionBits) / wide_t(other._raw)));
+    }
+
+    FixedPoint& operator+=(FixedPoint other){
+      return *this = *this + other;
+    }
+
+    FixedPoint& operator-=(FixedPoint other){
+      return *this = *this - other;
+    }
+
+    FixedPoint& operator*=(FixedPoint other){
+      return *this = *this * other;
+    }
+
+    // Comparison operators.
+    bool operator==(FixedPoint other) const{ return _raw == other._raw; }
+    bool operator!=(FixedPoint other) const{ return _raw != other._raw; }
+    bool operator<(FixedPoint other) const{ return _raw < other._raw; }
+    bool operator>(FixedPoint other) const{ return _raw > other._raw; }
+    bool operator<=(FixedPoint other) const{ return _raw <= other._raw; }
+    bool operator>=(FixedPoint other) const{ return _raw >= other._raw; }
+
+  protected:
+    // Integer type wide enough for the intermediate results of every operation.
+    typedef typename std::conditional<(sizeof(Integer_t) < 4), int32_t, int64_t>::type wide_t;
+
+    // Converts a double to the raw representation, rounding to nearest and saturating. NaN becomes zero.
+    static Integer_t fromDouble(double value){
+      double scaled = value * double(wide_t(1) << FractionBits);
+      if(scaled != scaled) return 0;
+      if(scaled >= double(std::numeric_limits<Integer_t>::max())) return std::numeric_limits<Integer_t>::max();
+      if(scaled <= double(std::numeric_limits<Integer_t>::min())) return std::numeric_limits<Integer_t>::min();
+      return Integer_t(std::llround(scaled));
+    }
+
+    // Clamps the supplied value to the range of Integer_t.
+    static Integer_t saturate(wide_t value){
+      if(value > wide_t(std::numeric_limits<Integer_t>::max())) return std::numeric_limits<Integer_t>::max();
+      if(value < wide_t(std::numeric_limits<Integer_t>::min())) return std::numeric_limits<Integer_t>::min();
+      return Integer_t(value);
+    }
+
+    Integer_t _raw;
+};
+
+// A 16-bit fixed-point number with 12 fractional bits, covering [-8, 8) in steps of 1/4096.
+typedef FixedPoint<int16_t, 12> Fixed16;
+
+// Elementary functions used by the activation functions. They are evaluated in double precision and rounded back.
+template<typename Integer_t, int FractionBits>
+FixedPoint<Integer_t, FractionBits> sin(FixedPoint<Integer_t, FractionBits> x){
+  return std::sin(double(x));
+}
+
+template<typename Integer_t, int FractionBits>
+FixedPoint<Integer_t, FractionBits> exp(FixedPoint<Integer_t, FractionBits> x){
+  return std::exp(double(x));
+}
+
+template<typename Integer_t, int FractionBits>
+FixedPoint<Integer_t, FractionBits> tanh(FixedPoint<Integer_t, FractionBits> x){
+  return std::tanh(double(x));
+}
+
+// Writes the value of a fixed-point number.
+template<typename Integer_t, int FractionBits>
+std::ostream& operator<<(std::ostream& os, FixedPoint<Integer_t, FractionBits> x){
+  return os << double(x);
+}
+
+#endif /* MISC_FIXEDPOINT_HPP_ */
@@ -0,0 +1,126 @@
+/*
+ * Misc_MappedFile.hpp
+ *
+ * Revision: October 2026
+ *
+ * A read-only view of a whole file, memory-mapped where the platform supports it.
+ */
+
+#ifndef MISC_MAPPEDFILE_HPP_
+#define MISC_MAPPEDFILE_HPP_
+
+// Standard libraries
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MISC_MAPPEDFILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A read-only view of the contents of a file.
+// On POSIX systems the file is memory-mapped; elsewhere it is read into memory.
+class MappedFile{
+  public:
+    // Constructor. Creates an empty view.
+    MappedFile():
+      _data(0),
+      _size(0),
+      _mapped(false){
+    }
+
+    // Constructor. Opens the indicated file.
+    explicit MappedFile(const std::string& fileName):
+      _data(0),
+      _size(0),
+      _mapped(false){
+      this->open(fileName);
+    }
+
+    // Destructor. Releases the view.
+    ~MappedFile(){
+      this->close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Opens the indicated file. Returns false if it cannot be read.
+    bool open(const std::string& fileName){
+      this->close();
+#ifdef MISC_MAPPEDFILE_MMAP
+      int descriptor = ::open(fileName.c_str(), O_RDONLY);
+      if(descriptor < 0){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+        return false;
+      }
+      struct stat status;
+      if(fstat(descriptor, &status) != 0){
+        ::close(descriptor);
+        std::cerr << "Could not read file: " << fileName << std::endl;
+        return false;
+      }
+      _size = size_t(status.st_size);
+      if(_size > 0){
+        void* address = mmap(0, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(address == MAP_FAILED){
+          ::close(descriptor);
+          _size = 0;
+          std::cerr << "Could not map file: " << fileName << std::endl;
+          return false;
+        }
+        _data = static_cast<const char*>(address);
+        _mapped = true;
+      }
+      ::close(descriptor);
+      return true;
+#else
+      std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+      if(!file.is_open()){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+        return false;
+      }
+      _buffer.resize(size_t(file.tellg()));
+      file.seekg(0);
+      file.read(_buffer.data(), _buffer.size());
+      _data = _buffer.data();
+      _size = _buffer.size();
+      return true;
+#endif
+    }
+
+    // Releases the view.
+    void close(){
+#ifdef MISC_MAPPEDFILE_MMAP
+      if(_mapped) munmap(const_cast<char*>(_data), _size);
+#endif
+      _buffer.clear();
+      _data = 0;
+      _size = 0;
+      _mapped = false;
+    }
+
+    // Returns the contents of the file.
+    const char* data() const{
+      return _data;
+    }
+
+    // Returns the size of the file in bytes.
+    size_t size() const{
+      return _size;
+    }
+
+  protected:
+    const char* _data;
+    size_t _size;
+    bool _mapped;
+    std::vector<char> _buffer;
+};
+
+#endif /* MISC_MAPPEDFILE_HPP_ */
@@ -5,6 +5,8 @@
  * Author: Thassyo Pinto - thassyo@ieee.org
  *
  * A collection of functions for creating random doubles.
+ * The functions draw from a RandomEngine owned by the calling thread, so they may be called concurrently.
+ * Every thread starts from its own stream until it is seeded.
  */
 
 #ifndef MISC_RANDOM_HPP_
@@ -15,27 +17,48 @@
 #include <time.h>
 #include <math.h>
 #include <iostream>
+#include <mutex>
 
-// Seeds the random number generator with the indicated seed.
+// Local libraries
+#include "Misc_RandomEngine.hpp"
+
+// Returns the engine of the next thread to use generator(). The engines are streams 2^128 draws apart of one
+// sequence, so threads that are never seeded draw different numbers; the first thread gets the default seed.
+inline RandomEngine nextThreadEngine(){
+  static std::mutex mutex;
+  static RandomEngine streams;
+  std::lock_guard<std::mutex> lock(mutex);
+  RandomEngine engine = streams;
+  streams.jump();
+  return engine;
+}
+
+// Returns the random number generator of the calling thread.
+inline RandomEngine& generator(){
+  static thread_local RandomEngine engine = nextThreadEngine();
+  return engine;
+}
+
+// Seeds the random number generator of the calling thread with the indicated seed.
 inline void seed(unsigned int seed){
 #ifdef DEBUG
   std::cout << "Seed set: " << seed << std::endl;
 #endif
-  srand(seed);
+  generator().seed(seed);
 }
 
-// Seeds the random number generator based on the current time.
+// Seeds the random number generator of the calling thread based on the current time.
 inline void seed(){
   time_t current_time = time(NULL);
 #ifdef DEBUG
   std::cout << "Seeded by time " << current_time << std::endl;
 #endif
-  srand(current_time);
+  generator().seed(current_time);
 }
 
 // Returns a random double in the interval [0, 1].
 inline double randDouble(){
-  double random = (double)rand()/(double)RAND_MAX;
+  double random = generator().randDouble();
 #ifdef DEBUG
   std::cout << "randDouble: " << random << std::endl;
 #endif
@@ -44,7 +67,7 @@ inline double randDouble(){
 
 // Returns a random double in the interval [0, max].
 inline double randDouble(double max){
-  double random = randDouble() * max;
+  double random = generator().randDouble(max);
 #ifdef DEBUG
   std::cout << "randDouble(max): " << random << std::endl;
 #endif
@@ -53,7 +76,7 @@ inline double randDouble(double max){
 
 // Returns a random double in the interval [min, max].
 inline double randDouble(double min, double max){
-  double random = randDouble() * (max - min) + min;
+  double random = generator().randDouble(min, max);
 #ifdef DEBUG
   std::cout << "randDouble(min,max): " << random << std::endl;
 #endif
@@ -62,10 +85,7 @@ inline double randDouble(double min, double max){
 
 // Returns a random integer in the interval [min, max].
 inline int randInt(int min, int max){
-  int randomIndex = int(randDouble(min, max));
-  while(randomIndex >= max){
-    randomIndex = int(randDouble(min, max));
-  }
+  int randomIndex = generator().randInt(min, max);
 #ifdef DEBUG
   std::cout << "randInt: " << randomIndex << std::endl;
 #endif
@@ -79,9 +99,7 @@ inline int randInt(int max){
 
 // Gaussian random function to produce a real number according to a Gaussian distribution.
 inline double randGaussian(double m=0.0,double v=1.0){
-  double factor = sqrt(-2.0f * log(randDouble()));
-  float angle  = 2.0f * M_PI * randDouble();
-  double random =  double(m + v * factor * cos(angle));
+  double random = generator().randGaussian(m, v);
 #ifdef DEBUG
   std::cout << "randGaussian: " << random << std::endl;
 #endif
@@ -90,10 +108,7 @@ inline double randGaussian(double m=0.0,double v=1.0){
 
 // Generates a random index in the range [min, max].
 inline size_t randIndex(size_t min, size_t max){
-  size_t randomIndex = size_t(randDouble(min, max));
-  while(randomIndex >= max){
-    randomIndex = size_t(randDouble(min, max));
-  }
+  size_t randomIndex = generator().randIndex(min, max);
 #ifdef DEBUG
   std::cout << "randIndex: " << randomIndex << std::endl;
 #endif
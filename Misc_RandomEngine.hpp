@@ -0,0 +1,295 @@
+/*
+ * Misc_RandomEngine.hpp
+ *
+ * Revision: October 2026
+ *
+ * A fast, seedable xoshiro256** random number engine with jump-ahead and bulk generation.
+ */
+
+#ifndef MISC_RANDOMENGINE_HPP_
+#define MISC_RANDOMENGINE_HPP_
+
+// Standard libraries
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// A xoshiro256** pseudo-random number engine (Blackman and Vigna).
+// Every engine is an independent generator with 256 bits of state. Copies produce the same sequence;
+// jump() and longJump() advance an engine by 2^128 and 2^192 draws to obtain non-overlapping streams.
+// The engine satisfies the UniformRandomBitGenerator requirements, so it works with <random> distributions.
+class RandomEngine{
+  public:
+    typedef uint64_t result_type;
+
+    // Complete state of an engine, including the spare value of the last Gaussian pair.
+    struct State{
+      uint64_t s[4];
+      double spareGaussian;
+      bool hasSpareGaussian;
+    };
+
+    // Constructor. Creates an engine seeded with the indicated seed.
+    explicit RandomEngine(uint64_t seed = 0){
+      this->seed(seed);
+    }
+
+    // Seeds the engine. The state is expanded from the seed with SplitMix64.
+    void seed(uint64_t seed){
+      for(int i = 0; i < 4; i++){
+        _state.s[i] = splitMix(seed);
+      }
+      _state.spareGaussian = 0.0;
+      _state.hasSpareGaussian = false;
+    }
+
+    // Returns the smallest value produced by the engine.
+    static constexpr result_type min(){
+      return 0;
+    }
+
+    // Returns the largest value produced by the engine.
+    static constexpr result_type max(){
+      return ~result_type(0);
+    }
+
+    // Returns the next 64 random bits.
+    result_type operator()(){
+      return next(_state.s);
+    }
+
+    // Advances the engine by 2^128 draws.
+    void jump(){
+      static const uint64_t polynomial[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+      this->jump(polynomial);
+    }
+
+    // Advances the engine by 2^192 draws.
+    void longJump(){
+      static const uint64_t polynomial[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+      this->jump(polynomial);
+    }
+
+    // Returns the complete state of the engine.
+    const State& getState() const{
+      return _state;
+    }
+
+    // Restores a state previously returned by getState().
+    void setState(const State& state){
+      _state = state;
+    }
+
+    // Returns a random double in the interval [0, 1].
+    double randDouble(){
+      return double((*this)() >> 11) * (1.0 / 9007199254740991.0);
+    }
+
+    // Returns a random double in the interval [0, max].
+    double randDouble(double max){
+      return this->randDouble() * max;
+    }
+
+    // Returns a random double in the interval [min, max].
+    double randDouble(double min, double max){
+      return this->randDouble() * (max - min) + min;
+    }
+
+    // Returns a random integer in the interval [min, max).
+    int randInt(int min, int max){
+      int random = int(this->randDouble(min, max));
+      while(random >= max){
+        random = int(this->randDouble(min, max));
+      }
+      return random;
+    }
+
+    // Returns a random integer in the interval [0, max).
+    int randInt(int max){
+      return this->randInt(0, max);
+    }
+
+    // Returns a random index in the interval [min, max).
+    size_t randIndex(size_t min, size_t max){
+      size_t random = size_t(this->randDouble(min, max));
+      while(random >= max){
+        random = size_t(this->randDouble(min, max));
+      }
+      return random;
+    }
+
+    // Returns a random index in the interval [0, max).
+    size_t randIndex(size_t max){
+      return this->randIndex(0, max);
+    }
+
+    // Returns a random number from a Gaussian distribution with mean m and standard deviation v.
+    // Both values of each Box-Muller pair are used.
+    double randGaussian(double m = 0.0, double v = 1.0){
+      if(_state.hasSpareGaussian){
+        _state.hasSpareGaussian = false;
+        return m + v * _state.spareGaussian;
+      }
+      double first, second;
+      boxMuller(openUnit((*this)()), openUnit((*this)()), first, second);
+      _state.spareGaussian = second;
+      _state.hasSpareGaussian = true;
+      return m + v * first;
+    }
+
+    // Returns the number of failures before the first success in a sequence of independent trials that succeed
+    // with probability p (a geometric distribution). Skipping that many elements visits exactly the elements a
+    // trial per element would select, at a cost proportional to their number. Returns max() if p is not positive.
+    size_t randGeometric(double p){
+      if(p >= 1.0) return 0;
+      if(!(p > 0.0)) return ~size_t(0);
+      double gap = std::floor(std::log(openUnit((*this)())) / std::log1p(-p));
+      return gap < 1.8e19 ? size_t(gap) : ~size_t(0);
+    }
+
+    // Fills the buffer with random doubles in the interval [min, max].
+    // Large buffers are generated by four interleaved engines seeded from this one,
+    // a loop the compiler can vectorize; the result does not depend on the instruction set.
+    void fillUniform(double* values, size_t n, double min = 0.0, double max = 1.0){
+      if(n < bulkThreshold){
+        for(size_t i = 0; i < n; i++){
+          values[i] = this->randDouble(min, max);
+        }
+        return;
+      }
+      Lanes lanes(*this);
+      double scale = (max - min) * (1.0 / 9007199254740991.0);
+      size_t i = 0;
+      uint64_t bits[Lanes::width];
+      for(; i + Lanes::width <= n; i += Lanes::width){
+        lanes.next(bits);
+        for(size_t j = 0; j < Lanes::width; j++){
+          values[i + j] = double(bits[j] >> 11) * scale + min;
+        }
+      }
+      for(; i < n; i++){
+        values[i] = this->randDouble(min, max);
+      }
+    }
+
+    // Fills the buffer with random numbers from a Gaussian distribution with mean m and standard deviation v.
+    void fillGaussian(double* values, size_t n, double m = 0.0, double v = 1.0){
+      if(n < bulkThreshold){
+        for(size_t i = 0; i < n; i++){
+          values[i] = this->randGaussian(m, v);
+        }
+        return;
+      }
+      Lanes lanes(*this);
+      size_t i = 0;
+      uint64_t bits[Lanes::width];
+      for(; i + Lanes::width <= n; i += Lanes::width){
+        lanes.next(bits);
+        for(size_t j = 0; j < Lanes::width; j += 2){
+          double first, second;
+          boxMuller(openUnit(bits[j]), openUnit(bits[j + 1]), first, second);
+          values[i + j] = m + v * first;
+          values[i + j + 1] = m + v * second;
+        }
+      }
+      for(; i < n; i++){
+        values[i] = this->randGaussian(m, v);
+      }
+    }
+
+  protected:
+    // Smallest buffer for which the interleaved bulk generators are used.
+    static constexpr size_t bulkThreshold = 64;
+
+    // Four xoshiro256** engines advanced together, stored lane by lane.
+    struct Lanes{
+      static constexpr size_t width = 4;
+      uint64_t s[4][width];
+
+      // Seeds the lanes from the supplied engine.
+      explicit Lanes(RandomEngine& engine){
+        for(size_t j = 0; j < width; j++){
+          uint64_t seed = engine();
+          for(int k = 0; k < 4; k++){
+            s[k][j] = splitMix(seed);
+          }
+        }
+      }
+
+      // Produces the next value of every lane.
+      void next(uint64_t* bits){
+        for(size_t j = 0; j < width; j++){
+          bits[j] = rotl(s[1][j] * 5, 7) * 9;
+          uint64_t t = s[1][j] << 17;
+          s[2][j] ^= s[0][j];
+          s[3][j] ^= s[1][j];
+          s[1][j] ^= s[2][j];
+          s[0][j] ^= s[3][j];
+          s[2][j] ^= t;
+          s[3][j] = rotl(s[3][j], 45);
+        }
+      }
+    };
+
+    // Rotates the bits of x to the left.
+    static uint64_t rotl(uint64_t x, int k){
+      return (x << k) | (x >> (64 - k));
+    }
+
+    // Advances a SplitMix64 generator and returns its output.
+    static uint64_t splitMix(uint64_t& x){
+      uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+    // Advances a xoshiro256** state and returns its output.
+    static uint64_t next(uint64_t* s){
+      uint64_t result = rotl(s[1] * 5, 7) * 9;
+      uint64_t t = s[1] << 17;
+      s[2] ^= s[0];
+      s[3] ^= s[1];
+      s[1] ^= s[2];
+      s[0] ^= s[3];
+      s[2] ^= t;
+      s[3] = rotl(s[3], 45);
+      return result;
+    }
+
+    // Converts 64 random bits to a double in the interval (0, 1].
+    static double openUnit(uint64_t bits){
+      return double((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+
+    // Transforms two uniform numbers in (0, 1] into two independent standard Gaussian numbers.
+    static void boxMuller(double u1, double u2, double& first, double& second){
+      double factor = std::sqrt(-2.0 * std::log(u1));
+      double angle = 2.0 * M_PI * u2;
+      first = factor * std::cos(angle);
+      second = factor * std::sin(angle);
+    }
+
+    // Advances the engine by the jump described by the supplied polynomial.
+    void jump(const uint64_t* polynomial){
+      uint64_t s[4] = {0, 0, 0, 0};
+      for(int i = 0; i < 4; i++){
+        for(int b = 0; b < 64; b++){
+          if(polynomial[i] & (uint64_t(1) << b)){
+            for(int k = 0; k < 4; k++){
+              s[k] ^= _state.s[k];
+            }
+          }
+          next(_state.s);
+        }
+      }
+      for(int k = 0; k < 4; k++){
+        _state.s[k] = s[k];
+      }
+      _state.hasSpareGaussian = false;
+    }
+
+    State _state;
+};
+
+#endif /* MISC_RANDOMENGINE_HPP_ */
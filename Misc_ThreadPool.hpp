@@ -0,0 +1,170 @@
+/*
+ * Misc_ThreadPool.hpp
+ *
+ * Revision: October 2026
+ *
+ * A fixed-size thread pool with per-worker task queues and work stealing.
+ */
+
+#ifndef MISC_THREADPOOL_HPP_
+#define MISC_THREADPOOL_HPP_
+
+// Standard libraries
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A thread pool with a fixed number of workers.
+// Every worker owns a task queue. It takes its own work from the back of that queue
+// and steals from the front of the other queues when its own queue is empty.
+class ThreadPool{
+  public:
+    typedef std::function<void()> task_t;
+
+    // Constructor. Starts the indicated number of workers (one per hardware thread if 0).
+    explicit ThreadPool(size_t nbOfThreads = 0):
+      _queued(0),
+      _sleeping(0),
+      _pending(0),
+      _next(0),
+      _stop(false){
+      if(nbOfThreads == 0) nbOfThreads = std::thread::hardware_concurrency();
+      if(nbOfThreads == 0) nbOfThreads = 1;
+      for(size_t i = 0; i < nbOfThreads; i++){
+        _queues.push_back(std::unique_ptr<Queue>(new Queue()));
+      }
+      for(size_t i = 0; i < nbOfThreads; i++){
+        _threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+      }
+    }
+
+    // Destructor. Finishes the queued tasks and joins the workers.
+    ~ThreadPool(){
+      this->wait();
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _workAvailable.notify_all();
+      for(size_t i = 0; i < _threads.size(); i++){
+        _threads[i].join();
+      }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Returns the number of workers.
+    size_t size() const{
+      return _threads.size();
+    }
+
+    // Queues a task. Tasks are distributed round-robin over the worker queues.
+    void submit(task_t task){
+      _pending++;
+      size_t index = _next++ % _queues.size();
+      // The task is counted before it becomes visible so that _queued never drops below zero.
+      _queued++;
+      {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+      }
+      // A worker counts itself as sleeping before it checks _queued, so either it sees the task or the task is
+      // counted before _sleeping is read here. Taking the mutex waits for it to be in wait() before notifying.
+      if(_sleeping > 0){
+        { std::lock_guard<std::mutex> lock(_mutex); }
+        _workAvailable.notify_one();
+      }
+    }
+
+    // Blocks until every submitted task has finished.
+    void wait(){
+      std::unique_lock<std::mutex> lock(_mutex);
+      _allDone.wait(lock, [this]{ return _pending == 0; });
+    }
+
+    // Calls function(i) for every i in [begin, end) on the workers and waits for completion.
+    template<typename Function_t>
+    void parallelFor(size_t begin, size_t end, Function_t function){
+      for(size_t i = begin; i < end; i++){
+        this->submit([function, i]{ function(i); });
+      }
+      this->wait();
+    }
+
+  protected:
+    // A task queue owned by one worker.
+    struct Queue{
+      std::mutex mutex;
+      std::deque<task_t> tasks;
+    };
+
+    // Takes a task from the back of the worker's own queue.
+    bool popLocal(size_t index, task_t& task){
+      std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+      if(_queues[index]->tasks.empty()) return false;
+      task = std::move(_queues[index]->tasks.back());
+      _queues[index]->tasks.pop_back();
+      return true;
+    }
+
+    // Takes a task from the front of another worker's queue.
+    bool steal(size_t index, task_t& task){
+      for(size_t i = 1; i < _queues.size(); i++){
+        Queue& victim = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+      return false;
+    }
+
+    // Main loop of a worker.
+    void workerLoop(size_t index){
+      while(true){
+        if(_queued == 0){
+          std::unique_lock<std::mutex> lock(_mutex);
+          _sleeping++;
+          _workAvailable.wait(lock, [this]{ return _stop || _queued > 0; });
+          _sleeping--;
+          if(_stop && _queued == 0) return;
+        }
+        task_t task;
+        if(!this->popLocal(index, task) && !this->steal(index, task)){
+          // The task is counted but not pushed yet, or another worker took it.
+          std::this_thread::yield();
+          continue;
+        }
+        _queued--;
+        task();
+        if(--_pending == 0){
+          std::lock_guard<std::mutex> lock(_mutex);
+          _allDone.notify_all();
+        }
+      }
+    }
+
+    std::vector<std::unique_ptr<Queue> > _queues;
+    std::vector<std::thread> _threads;
+
+    // Number of tasks waiting in the queues, of workers waiting for tasks and of unfinished tasks.
+    std::atomic<size_t> _queued;
+    std::atomic<size_t> _sleeping;
+    std::atomic<size_t> _pending;
+    std::atomic<size_t> _next;
+    bool _stop;
+
+    // Guards _stop and the sleeping and waking of workers and of wait().
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _allDone;
+};
+
+#endif /* MISC_THREADPOOL_HPP_ */
@@ -0,0 +1,143 @@
+/*
+ * Misc_WorkerTeam.hpp
+ *
+ * Revision: October 2026
+ *
+ * A team of persistent threads that run the same function together, for fine-grained parallel loops.
+ */
+
+#ifndef MISC_WORKERTEAM_HPP_
+#define MISC_WORKERTEAM_HPP_
+
+// Standard libraries
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// A fixed team of threads: the calling thread plus size() - 1 workers.
+// run() starts a function on every member and returns when all of them finished, which costs one barrier.
+// Between runs the workers spin for a short while and then sleep, so back-to-back runs start quickly
+// without an idle team keeping the cores busy. Unlike ThreadPool there are no task queues; each member
+// gets its index and picks its own share of the work.
+class WorkerTeam{
+  public:
+    typedef std::function<void(size_t)> task_t;
+
+    // Constructor. Creates a team of the indicated number of threads (one per hardware thread if 0).
+    explicit WorkerTeam(size_t nbOfThreads = 0):
+      _task(0),
+      _generation(0),
+      _remaining(0),
+      _sleeping(0),
+      _stop(false){
+      if(nbOfThreads == 0) nbOfThreads = std::thread::hardware_concurrency();
+      if(nbOfThreads == 0) nbOfThreads = 1;
+      for(size_t i = 1; i < nbOfThreads; i++){
+        _threads.push_back(std::thread(&WorkerTeam::workerLoop, this, i));
+      }
+    }
+
+    // Destructor. Stops and joins the workers.
+    ~WorkerTeam(){
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop.store(true, std::memory_order_release);
+        _generation++;
+      }
+      _wake.notify_all();
+      for(size_t i = 0; i < _threads.size(); i++){
+        _threads[i].join();
+      }
+    }
+
+    WorkerTeam(const WorkerTeam&) = delete;
+    WorkerTeam& operator=(const WorkerTeam&) = delete;
+
+    // Returns the number of threads of the team, including the calling thread.
+    size_t size() const{
+      return _threads.size() + 1;
+    }
+
+    // Calls task(i) on thread i of the team for every i in [0, size()) and waits for all calls to return.
+    // Index 0 runs on the calling thread. Concurrent calls from different threads are serialized.
+    void run(const task_t& task){
+      std::lock_guard<std::mutex> runLock(_runMutex);
+      _task = &task;
+      _remaining.store(_threads.size(), std::memory_order_relaxed);
+      bool sleeping;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _generation.fetch_add(1, std::memory_order_release);
+        sleeping = _sleeping > 0;
+      }
+      if(sleeping) _wake.notify_all();
+      task(0);
+      for(size_t spins = 0; _remaining.load(std::memory_order_acquire) != 0; spins++){
+        pause(spins);
+      }
+    }
+
+  protected:
+    // Number of polls before a waiting thread yields, and before an idle worker goes to sleep.
+    static constexpr size_t spinsBeforeYield = 1000;
+    static constexpr size_t spinsBeforeSleep = 20000;
+
+    // Waits a little, yielding the core after a number of attempts.
+    static void pause(size_t spins){
+      if(spins < spinsBeforeYield){
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+      }
+      else{
+        std::this_thread::yield();
+      }
+    }
+
+    // Main loop of a worker.
+    void workerLoop(size_t index){
+      size_t seen = 0;
+      while(true){
+        size_t generation = _generation.load(std::memory_order_acquire);
+        for(size_t spins = 0; generation == seen && spins < spinsBeforeSleep; spins++){
+          pause(spins);
+          generation = _generation.load(std::memory_order_acquire);
+        }
+        if(generation == seen){
+          std::unique_lock<std::mutex> lock(_mutex);
+          _sleeping++;
+          _wake.wait(lock, [this, seen]{ return _generation.load(std::memory_order_acquire) != seen; });
+          _sleeping--;
+          generation = _generation.load(std::memory_order_acquire);
+        }
+        seen = generation;
+        if(_stop.load(std::memory_order_acquire)) return;
+        (*_task)(index);
+        _remaining.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    }
+
+    std::vector<std::thread> _threads;
+
+    // The function of the current run, the number of runs started and the workers still in the current run.
+    const task_t* _task;
+    std::atomic<size_t> _generation;
+    std::atomic<size_t> _remaining;
+
+    // Number of sleeping workers (guarded by _mutex), and the stop flag.
+    size_t _sleeping;
+    std::atomic<bool> _stop;
+
+    std::mutex _mutex;
+    std::mutex _runMutex;
+    std::condition_variable _wake;
+};
+
+#endif /* MISC_WORKERTEAM_HPP_ */
@@ -0,0 +1,544 @@
+/*
+ * RNN_Activation.hpp
+ *
+ * Revision: October 2026
+ *
+ * Batch activation kernels that apply one activation function to a contiguous range of neurons.
+ * The double and float kernels use AVX2 or SSE2 when the compiler targets them and fall back to scalar code otherwise;
+ * other scalar types, such as fixed point, use scalar code.
+ *
+ * Every activation function can be evaluated at one of three precisions: exactly with the standard library,
+ * with the polynomial approximations of Misc_FastMath.hpp, or with interpolation tables. The approximations
+ * apply to float and double; other scalar types are always evaluated exactly.
+ *
+ * At the exact precision only the linear kernel is vectorized throughout: the sine, Gaussian and sigmoid kernels
+ * vectorize the additions and multiplications around the call, but std::sin, std::exp and std::tanh are called once
+ * per neuron. At the polynomial precision these three run entirely on vectors, and the tables are scalar.
+ */
+
+#ifndef RNN_ACTIVATION_HPP_
+#define RNN_ACTIVATION_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Local libraries
+#include "Misc_FastMath.hpp"
+#include "RNN_Neuron.hpp"
+
+// A collection of batch activation kernels.
+// Every kernel computes value[i] = f(incoming[i] + bias[i]) for i in [0, n).
+class Activation{
+  public:
+    // Number of neurons processed per chunk by the kernels that need a scratch buffer.
+    static constexpr size_t chunkSize = 256;
+
+    // Precision at which activation functions are evaluated.
+    enum precision_t{
+      exact,
+      polynomial,
+      table
+    };
+
+    // Maximum and mean absolute error of an approximation against the exact activation function,
+    // and time per value of the approximation.
+    struct ErrorEstimate{
+      double maxError;
+      double meanError;
+      double nanoseconds;
+    };
+
+    // Applies the indicated activation function to a contiguous range of neurons, at the indicated precision.
+    template<typename Scalar_t>
+    static void apply(Neuron::af_t activation, precision_t precision, const Scalar_t* incoming, const Scalar_t* bias,
+                      const Scalar_t* lambda, Scalar_t* value, size_t n){
+      if constexpr(std::is_same<Scalar_t, double>::value || std::is_same<Scalar_t, float>::value){
+        if(precision != exact && activation != Neuron::linear){
+          approximate(activation, precision, incoming, bias, lambda, value, n);
+          return;
+        }
+      }
+      apply(activation, incoming, bias, lambda, value, n);
+    }
+
+    // Returns the indicated activation function of x, at the indicated precision.
+    // The result is the same as apply() gives for a neuron with the same incoming potential plus bias.
+    template<typename Scalar_t>
+    static Scalar_t activate(Neuron::af_t activation, precision_t precision, Scalar_t x, Scalar_t lambda){
+      if(precision == exact) return Neuron::activate(activation, x, lambda);
+      Scalar_t zero = Scalar_t(0);
+      Scalar_t value = Scalar_t(0);
+      apply(activation, precision, &x, &zero, &lambda, &value, 1);
+      return value;
+    }
+
+    // Compares the indicated activation function at the indicated precision against the exact one,
+    // at evenly spaced points of [min, max]. For the sigmoid, the points are values of x*lambda.
+    template<typename Scalar_t>
+    static ErrorEstimate estimateError(Neuron::af_t activation, precision_t precision, double min, double max, size_t nbOfPoints = 65536){
+      std::vector<Scalar_t> x(nbOfPoints), zero(nbOfPoints, Scalar_t(0)), one(nbOfPoints, Scalar_t(1));
+      std::vector<Scalar_t> expected(nbOfPoints), actual(nbOfPoints);
+      for(size_t i = 0; i < nbOfPoints; i++){
+        x[i] = Scalar_t(nbOfPoints > 1 ? min + (max - min) * double(i) / double(nbOfPoints - 1) : min);
+      }
+      apply(activation, exact, x.data(), zero.data(), one.data(), expected.data(), nbOfPoints);
+      size_t repetitions = 0;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      do{
+        apply(activation, precision, x.data(), zero.data(), one.data(), actual.data(), nbOfPoints);
+        repetitions++;
+      }while(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(10));
+      double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      ErrorEstimate estimate = {0.0, 0.0, elapsed / double(repetitions * nbOfPoints)};
+      for(size_t i = 0; i < nbOfPoints; i++){
+        double error = std::fabs(double(actual[i]) - double(expected[i]));
+        if(error > estimate.maxError) estimate.maxError = error;
+        estimate.meanError += error / double(nbOfPoints);
+      }
+      return estimate;
+    }
+
+    // Writes the errors and times of every precision of the indicated activation function over [min, max].
+    template<typename Scalar_t>
+    static void report(std::ostream& output, Neuron::af_t activation, double min, double max){
+      static const char* precisions[3] = {"exact", "polynomial", "table"};
+      for(int i = 0; i < 3; i++){
+        ErrorEstimate estimate = estimateError<Scalar_t>(activation, precision_t(i), min, max);
+        output << getName(activation) << " [" << min << ", " << max << "] " << precisions[i]
+               << ": max error " << estimate.maxError << ", mean error " << estimate.meanError
+               << ", " << estimate.nanoseconds << " ns per value" << std::endl;
+      }
+    }
+
+    // Returns the name of an activation function.
+    static const char* getName(Neuron::af_t activation){
+      static const char* names[4] = {"linear", "sine", "gaussian", "sigmoid"};
+      return activation >= 0 && activation < 4 ? names[activation] : "unknown";
+    }
+
+    // Applies the indicated activation function to a contiguous range of neurons.
+    template<typename Scalar_t>
+    static void apply(Neuron::af_t activation, const Scalar_t* incoming, const Scalar_t* bias, const Scalar_t* lambda, Scalar_t* value, size_t n){
+      switch(activation){
+        case Neuron::linear:
+          linear(incoming, bias, value, n);
+          break;
+        case Neuron::sine:
+          sine(incoming, bias, value, n);
+          break;
+        case Neuron::gaussian:
+          gaussian(incoming, bias, value, n);
+          break;
+        case Neuron::sigmoid:
+          sigmoid(incoming, bias, lambda, value, n);
+          break;
+        default:
+          std::cout << "Error! No activation function found!" << std::endl;
+          break;
+      }
+    }
+
+    // Identity truncated to [-1, 1]. NaN inputs are passed through unchanged.
+    static void linear(const double* incoming, const double* bias, double* value, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256d one = _mm256_set1_pd(1.0);
+      const __m256d minusOne = _mm256_set1_pd(-1.0);
+      for(; i + 4 <= n; i += 4){
+        __m256d x = _mm256_add_pd(_mm256_loadu_pd(incoming + i), _mm256_loadu_pd(bias + i));
+        _mm256_storeu_pd(value + i, _mm256_max_pd(minusOne, _mm256_min_pd(one, x)));
+      }
+#elif defined(__SSE2__)
+      const __m128d one = _mm_set1_pd(1.0);
+      const __m128d minusOne = _mm_set1_pd(-1.0);
+      for(; i + 2 <= n; i += 2){
+        __m128d x = _mm_add_pd(_mm_loadu_pd(incoming + i), _mm_loadu_pd(bias + i));
+        _mm_storeu_pd(value + i, _mm_max_pd(minusOne, _mm_min_pd(one, x)));
+      }
+#endif
+      for(; i < n; i++){
+        value[i] = Neuron::activate(Neuron::linear, incoming[i] + bias[i], 0.0);
+      }
+    }
+
+    // Identity truncated to [-1, 1], in single precision. NaN inputs are passed through unchanged.
+    static void linear(const float* incoming, const float* bias, float* value, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256 one = _mm256_set1_ps(1.0f);
+      const __m256 minusOne = _mm256_set1_ps(-1.0f);
+      for(; i + 8 <= n; i += 8){
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(incoming + i), _mm256_loadu_ps(bias + i));
+        _mm256_storeu_ps(value + i, _mm256_max_ps(minusOne, _mm256_min_ps(one, x)));
+      }
+#elif defined(__SSE2__)
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 minusOne = _mm_set1_ps(-1.0f);
+      for(; i + 4 <= n; i += 4){
+        __m128 x = _mm_add_ps(_mm_loadu_ps(incoming + i), _mm_loadu_ps(bias + i));
+        _mm_storeu_ps(value + i, _mm_max_ps(minusOne, _mm_min_ps(one, x)));
+      }
+#endif
+      for(; i < n; i++){
+        value[i] = Neuron::activate(Neuron::linear, incoming[i] + bias[i], 0.0f);
+      }
+    }
+
+    // Identity truncated to [-1, 1], for other scalar types.
+    template<typename Scalar_t>
+    static void linear(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n){
+      for(size_t i = 0; i < n; i++){
+        value[i] = Neuron::activate(Neuron::linear, incoming[i] + bias[i], Scalar_t(0));
+      }
+    }
+
+    // Sine-wave f(x) = sin(x).
+    template<typename Scalar_t>
+    static void sine(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n){
+      using std::sin;
+      Scalar_t x[chunkSize];
+      for(size_t begin = 0; begin < n; begin += chunkSize){
+        size_t count = std::min(chunkSize, n - begin);
+        add(incoming + begin, bias + begin, x, count);
+        for(size_t i = 0; i < count; i++){
+          value[begin + i] = sin(x[i]);
+        }
+      }
+    }
+
+    // Gaussian f(x) = e^(-x*x), scaled to lie in [-1, 1].
+    template<typename Scalar_t>
+    static void gaussian(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n){
+      using std::exp;
+      Scalar_t x[chunkSize];
+      for(size_t begin = 0; begin < n; begin += chunkSize){
+        size_t count = std::min(chunkSize, n - begin);
+        add(incoming + begin, bias + begin, x, count);
+        negateSquare(x, count);
+        for(size_t i = 0; i < count; i++){
+          x[i] = exp(x[i]);
+        }
+        scaleToUnitRange(x, value + begin, count);
+      }
+    }
+
+    // Sigmoid f(x) = tanh(x*lambda).
+    template<typename Scalar_t>
+    static void sigmoid(const Scalar_t* incoming, const Scalar_t* bias, const Scalar_t* lambda, Scalar_t* value, size_t n){
+      using std::tanh;
+      Scalar_t x[chunkSize];
+      for(size_t begin = 0; begin < n; begin += chunkSize){
+        size_t count = std::min(chunkSize, n - begin);
+        add(incoming + begin, bias + begin, x, count);
+        multiply(x, lambda + begin, count);
+        for(size_t i = 0; i < count; i++){
+          value[begin + i] = tanh(x[i]);
+        }
+      }
+    }
+
+  protected:
+    // Applies the polynomial or table version of a non-linear activation function.
+    template<typename Scalar_t>
+    static void approximate(Neuron::af_t activation, precision_t precision, const Scalar_t* incoming, const Scalar_t* bias,
+                            const Scalar_t* lambda, Scalar_t* value, size_t n){
+      switch(activation){
+        case Neuron::sine:
+          if(precision == polynomial){
+            polynomialSine(incoming, bias, value, n);
+          }
+          else{
+            const InterpolationTable& table = sineTable();
+            map(incoming, bias, value, n, [&](Scalar_t x){ return Scalar_t(table.evaluate(double(FastMath::reduce(x)))); });
+          }
+          break;
+        case Neuron::gaussian:
+          if(precision == polynomial){
+            polynomialGaussian(incoming, bias, value, n);
+          }
+          else{
+            const InterpolationTable& table = gaussianTable();
+            map(incoming, bias, value, n, [&](Scalar_t x){ return Scalar_t(table.evaluate(double(x))); });
+          }
+          break;
+        case Neuron::sigmoid:
+          if(precision == polynomial){
+            polynomialSigmoid(incoming, bias, lambda, value, n);
+          }
+          else{
+            const InterpolationTable& table = sigmoidTable();
+            for(size_t i = 0; i < n; i++){
+              value[i] = Scalar_t(table.evaluate(double((incoming[i] + bias[i]) * lambda[i])));
+            }
+          }
+          break;
+        default:
+          std::cout << "Error! No activation function found!" << std::endl;
+          break;
+      }
+    }
+
+    // Polynomial sine, a vector at a time where the compiler targets AVX2 or SSE2.
+    template<typename Scalar_t>
+    static void polynomialSine(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+      typedef VectorOps<Scalar_t> ops;
+      for(; i + ops::lanes <= n; i += ops::lanes){
+        ops::store(value + i, FastMath::vectorSin<Scalar_t>(ops::add(ops::load(incoming + i), ops::load(bias + i))));
+      }
+#endif
+      for(; i < n; i++){
+        value[i] = FastMath::sin(incoming[i] + bias[i]);
+      }
+    }
+
+    // Polynomial Gaussian, scaled to lie in [-1, 1].
+    template<typename Scalar_t>
+    static void polynomialGaussian(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+      typedef VectorOps<Scalar_t> ops;
+      for(; i + ops::lanes <= n; i += ops::lanes){
+        typename ops::vector_t x = ops::add(ops::load(incoming + i), ops::load(bias + i));
+        typename ops::vector_t e = FastMath::vectorExp<Scalar_t>(ops::mul(ops::negate(x), x));
+        ops::store(value + i, ops::sub(ops::mul(e, ops::set(Scalar_t(2))), ops::set(Scalar_t(1))));
+      }
+#endif
+      for(; i < n; i++){
+        Scalar_t x = incoming[i] + bias[i];
+        value[i] = FastMath::exp(-x*x) * Scalar_t(2) - Scalar_t(1);
+      }
+    }
+
+    // Polynomial sigmoid.
+    template<typename Scalar_t>
+    static void polynomialSigmoid(const Scalar_t* incoming, const Scalar_t* bias, const Scalar_t* lambda, Scalar_t* value, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+      typedef VectorOps<Scalar_t> ops;
+      for(; i + ops::lanes <= n; i += ops::lanes){
+        typename ops::vector_t x = ops::mul(ops::add(ops::load(incoming + i), ops::load(bias + i)), ops::load(lambda + i));
+        ops::store(value + i, FastMath::vectorTanh<Scalar_t>(x));
+      }
+#endif
+      for(; i < n; i++){
+        value[i] = FastMath::tanh((incoming[i] + bias[i]) * lambda[i]);
+      }
+    }
+
+    // Computes value[i] = f(incoming[i] + bias[i]).
+    template<typename Scalar_t, typename Function>
+    static void map(const Scalar_t* incoming, const Scalar_t* bias, Scalar_t* value, size_t n, Function function){
+      for(size_t i = 0; i < n; i++){
+        value[i] = function(incoming[i] + bias[i]);
+      }
+    }
+
+    // Interpolation tables of the activation functions, built on first use.
+    // Beyond the sampled ranges the functions are within 1e-8 of their limits.
+    static const InterpolationTable& sineTable(){
+      static const InterpolationTable sineTable(-3.14159265358979323846, 3.14159265358979323846, 8192, [](double x){ return std::sin(x); });
+      return sineTable;
+    }
+
+    static const InterpolationTable& gaussianTable(){
+      static const InterpolationTable gaussianTable(-5.0, 5.0, 8192, [](double x){ return std::exp(-x*x) * 2.0 - 1.0; });
+      return gaussianTable;
+    }
+
+    static const InterpolationTable& sigmoidTable(){
+      static const InterpolationTable sigmoidTable(-10.0, 10.0, 8192, [](double x){ return std::tanh(x); });
+      return sigmoidTable;
+    }
+
+    // Computes out[i] = a[i] + b[i].
+    static void add(const double* a, const double* b, double* out, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      for(; i + 4 <= n; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+      }
+#elif defined(__SSE2__)
+      for(; i + 2 <= n; i += 2){
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+      }
+#endif
+      for(; i < n; i++){
+        out[i] = a[i] + b[i];
+      }
+    }
+
+    // Computes x[i] = x[i] * factor[i].
+    static void multiply(double* x, const double* factor, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      for(; i + 4 <= n; i += 4){
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(factor + i)));
+      }
+#elif defined(__SSE2__)
+      for(; i + 2 <= n; i += 2){
+        _mm_storeu_pd(x + i, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(factor + i)));
+      }
+#endif
+      for(; i < n; i++){
+        x[i] = x[i] * factor[i];
+      }
+    }
+
+    // Computes x[i] = -x[i]*x[i].
+    static void negateSquare(double* x, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256d signMask = _mm256_set1_pd(-0.0);
+      for(; i + 4 <= n; i += 4){
+        __m256d v = _mm256_loadu_pd(x + i);
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_xor_pd(v, signMask), v));
+      }
+#elif defined(__SSE2__)
+      const __m128d signMask = _mm_set1_pd(-0.0);
+      for(; i + 2 <= n; i += 2){
+        __m128d v = _mm_loadu_pd(x + i);
+        _mm_storeu_pd(x + i, _mm_mul_pd(_mm_xor_pd(v, signMask), v));
+      }
+#endif
+      for(; i < n; i++){
+        x[i] = -x[i]*x[i];
+      }
+    }
+
+    // Computes out[i] = x[i] * 2 - 1.
+    static void scaleToUnitRange(const double* x, double* out, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256d two = _mm256_set1_pd(2.0);
+      const __m256d one = _mm256_set1_pd(1.0);
+      for(; i + 4 <= n; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), two), one));
+      }
+#elif defined(__SSE2__)
+      const __m128d two = _mm_set1_pd(2.0);
+      const __m128d one = _mm_set1_pd(1.0);
+      for(; i + 2 <= n; i += 2){
+        _mm_storeu_pd(out + i, _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(x + i), two), one));
+      }
+#endif
+      for(; i < n; i++){
+        out[i] = x[i] * 2.0 - 1.0;
+      }
+    }
+
+    // Single precision versions of the helpers above, processing twice as many values per instruction.
+    static void add(const float* a, const float* b, float* out, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      for(; i + 8 <= n; i += 8){
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+      }
+#elif defined(__SSE2__)
+      for(; i + 4 <= n; i += 4){
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+      }
+#endif
+      for(; i < n; i++){
+        out[i] = a[i] + b[i];
+      }
+    }
+
+    static void multiply(float* x, const float* factor, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      for(; i + 8 <= n; i += 8){
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(factor + i)));
+      }
+#elif defined(__SSE2__)
+      for(; i + 4 <= n; i += 4){
+        _mm_storeu_ps(x + i, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(factor + i)));
+      }
+#endif
+      for(; i < n; i++){
+        x[i] = x[i] * factor[i];
+      }
+    }
+
+    static void negateSquare(float* x, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256 signMask = _mm256_set1_ps(-0.0f);
+      for(; i + 8 <= n; i += 8){
+        __m256 v = _mm256_loadu_ps(x + i);
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(_mm256_xor_ps(v, signMask), v));
+      }
+#elif defined(__SSE2__)
+      const __m128 signMask = _mm_set1_ps(-0.0f);
+      for(; i + 4 <= n; i += 4){
+        __m128 v = _mm_loadu_ps(x + i);
+        _mm_storeu_ps(x + i, _mm_mul_ps(_mm_xor_ps(v, signMask), v));
+      }
+#endif
+      for(; i < n; i++){
+        x[i] = -x[i]*x[i];
+      }
+    }
+
+    static void scaleToUnitRange(const float* x, float* out, size_t n){
+      size_t i = 0;
+#if defined(__AVX2__)
+      const __m256 two = _mm256_set1_ps(2.0f);
+      const __m256 one = _mm256_set1_ps(1.0f);
+      for(; i + 8 <= n; i += 8){
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(x + i), two), one));
+      }
+#elif defined(__SSE2__)
+      const __m128 two = _mm_set1_ps(2.0f);
+      const __m128 one = _mm_set1_ps(1.0f);
+      for(; i + 4 <= n; i += 4){
+        _mm_storeu_ps(out + i, _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(x + i), two), one));
+      }
+#endif
+      for(; i < n; i++){
+        out[i] = x[i] * 2.0f - 1.0f;
+      }
+    }
+
+    // Scalar versions of the helpers above for other scalar types.
+    template<typename Scalar_t>
+    static void add(const Scalar_t* a, const Scalar_t* b, Scalar_t* out, size_t n){
+      for(size_t i = 0; i < n; i++){
+        out[i] = a[i] + b[i];
+      }
+    }
+
+    template<typename Scalar_t>
+    static void multiply(Scalar_t* x, const Scalar_t* factor, size_t n){
+      for(size_t i = 0; i < n; i++){
+        x[i] = x[i] * factor[i];
+      }
+    }
+
+    template<typename Scalar_t>
+    static void negateSquare(Scalar_t* x, size_t n){
+      for(size_t i = 0; i < n; i++){
+        x[i] = -x[i]*x[i];
+      }
+    }
+
+    template<typename Scalar_t>
+    static void scaleToUnitRange(const Scalar_t* x, Scalar_t* out, size_t n){
+      for(size_t i = 0; i < n; i++){
+        out[i] = x[i] * Scalar_t(2) - Scalar_t(1);
+      }
+    }
+};
+
+#endif /* RNN_ACTIVATION_HPP_ */
@@ -0,0 +1,262 @@
+/*
+ * RNN_AdjacencyArena.hpp
+ *
+ * Revision: October 2026
+ *
+ * Flat storage of the connection index lists of all neurons of a network.
+ */
+
+#ifndef RNN_ADJACENCYARENA_HPP_
+#define RNN_ADJACENCYARENA_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Local libraries
+#include "Misc_CopyOnWrite.hpp"
+
+// The index lists of many neurons stored in a few shared vectors, instead of one vector per neuron.
+// Lists are grouped in blocks of blockSize consecutive lists; each block keeps its lists in one pool, as spans
+// (offset, length, capacity). Appending to a full list moves it to the end of its pool with twice the capacity,
+// leaving a hole; when holes make up more than half of a pool, its lists are packed again in list order.
+// Blocks are shared between copies of the arena and copied on the first write (see Misc_CopyOnWrite.hpp), so copying
+// an arena costs one allocation and one reference per block, and changing a list copies at most its own block.
+template<typename Index_t = size_t>
+class AdjacencyArena{
+  public:
+    typedef Index_t index_t;
+
+    // A read-only view of one list, valid until the arena is modified.
+    class List{
+      public:
+        // Constructor. Views the indicated number of indices.
+        List(const Index_t* data, size_t size):
+          _data(data),
+          _size(size){
+        }
+
+        // Returns the number of indices of the list.
+        size_t size() const{
+          return _size;
+        }
+
+        // Returns true if the list holds no indices.
+        bool empty() const{
+          return _size == 0;
+        }
+
+        // Returns the indicated index of the list.
+        Index_t operator[](size_t position) const{
+          return _data[position];
+        }
+
+        // Returns a pointer to the first index.
+        const Index_t* begin() const{
+          return _data;
+        }
+
+        // Returns a pointer past the last index.
+        const Index_t* end() const{
+          return _data + _size;
+        }
+
+      protected:
+        const Index_t* _data;
+        size_t _size;
+    };
+
+    // Capacity of a list when it gets its first index.
+    static constexpr size_t minCapacity = 4;
+
+    // Number of lists per block (a power of two).
+    static constexpr size_t blockBits = 8;
+    static constexpr size_t blockSize = size_t(1) << blockBits;
+
+    // Constructor. Creates an arena without lists.
+    AdjacencyArena():
+      _nbOfLists(0),
+      _indicesPerList(0){
+    }
+
+    // Removes all lists.
+    void clear(){
+      _blocks.clear();
+      _nbOfLists = 0;
+    }
+
+    // Reserves storage for the indicated number of lists and indices.
+    void reserve(size_t nbOfLists, size_t nbOfIndices){
+      _blocks.reserve((nbOfLists + blockSize - 1) >> blockBits);
+      _indicesPerList = nbOfLists > 0 ? nbOfIndices / nbOfLists : 0;
+    }
+
+    // Adds an empty list at the end.
+    void addList(){
+      if((_nbOfLists & (blockSize - 1)) == 0){
+        _blocks.push_back(CowPointer<Block>());
+        _blocks.back().write().spans.reserve(blockSize);
+        _blocks.back().write().pool.reserve(blockSize * _indicesPerList);
+      }
+      _blocks.back().write().spans.push_back(Span());
+      _nbOfLists++;
+    }
+
+    // Returns the number of lists.
+    size_t size() const{
+      return _nbOfLists;
+    }
+
+    // Returns a view of the indicated list.
+    List get(size_t list) const{
+      const Block& block = *_blocks[list >> blockBits];
+      const Span& span = block.spans[list & (blockSize - 1)];
+      return List(block.pool.data() + span.offset, span.length);
+    }
+
+    // Appends an index to the indicated list.
+    void append(size_t list, size_t index){
+      Block& block = _blocks[list >> blockBits].write();
+      Span& span = block.spans[list & (blockSize - 1)];
+      if(span.length == span.capacity) block.grow(span);
+      block.pool[span.offset + span.length++] = Index_t(index);
+    }
+
+    // Removes the first occurrence of an index from the indicated list, keeping the order of the others.
+    void remove(size_t list, size_t index){
+      Block& block = _blocks[list >> blockBits].write();
+      Span& span = block.spans[list & (blockSize - 1)];
+      Index_t* first = block.pool.data() + span.offset;
+      Index_t* last = first + span.length;
+      Index_t* position = std::find(first, last, Index_t(index));
+      if(position == last) return;
+      std::copy(position + 1, last, position);
+      span.length--;
+    }
+
+    // Replaces every index i of every list by remap[i].
+    void remap(const std::vector<size_t>& remap){
+      for(size_t i = 0; i < _blocks.size(); i++){
+        Block& block = _blocks[i].write();
+        for(size_t j = 0; j < block.spans.size(); j++){
+          Index_t* indices = block.pool.data() + block.spans[j].offset;
+          for(size_t k = 0; k < block.spans[j].length; k++){
+            indices[k] = Index_t(remap[indices[k]]);
+          }
+        }
+      }
+    }
+
+    // Packs the lists of every block in list order, each with a capacity equal to its length.
+    void compact(){
+      for(size_t i = 0; i < _blocks.size(); i++){
+        _blocks[i].write().compact();
+      }
+    }
+
+    // Moves every list i to position permutation[i], packing the lists in their new order.
+    void permute(const std::vector<size_t>& permutation){
+      std::vector<size_t> order(_nbOfLists);
+      for(size_t i = 0; i < _nbOfLists; i++){
+        order[permutation[i]] = i;
+      }
+      AdjacencyArena arena;
+      arena._blocks.reserve(_blocks.size());
+      for(size_t i = 0; i < _nbOfLists; i++){
+        arena.addList();
+        List list = this->get(order[i]);
+        Block& block = arena._blocks.back().write();
+        Span& span = block.spans.back();
+        span.offset = block.pool.size();
+        span.length = list.size();
+        span.capacity = list.size();
+        block.pool.insert(block.pool.end(), list.begin(), list.end());
+      }
+      _blocks.swap(arena._blocks);
+    }
+
+    // Returns the number of slots of the pools, including unused capacity and holes.
+    size_t getPoolSize() const{
+      size_t poolSize = 0;
+      for(size_t i = 0; i < _blocks.size(); i++){
+        poolSize += _blocks[i]->pool.size();
+      }
+      return poolSize;
+    }
+
+    // Returns the number of blocks shared with other arenas.
+    size_t getNbOfSharedBlocks() const{
+      size_t nbOfShared = 0;
+      for(size_t i = 0; i < _blocks.size(); i++){
+        if(_blocks[i].isShared()) nbOfShared++;
+      }
+      return nbOfShared;
+    }
+
+  protected:
+    // Position of a list in the pool of its block.
+    struct Span{
+      Span():
+        offset(0),
+        length(0),
+        capacity(0){
+      }
+
+      size_t offset;
+      size_t length;
+      size_t capacity;
+    };
+
+    // The lists of blockSize consecutive neurons and the pool holding them.
+    struct Block{
+      Block():
+        nbOfHoles(0){
+      }
+
+      // Moves the supplied full list to the end of the pool with twice its capacity.
+      void grow(Span& span){
+        if(nbOfHoles + span.capacity > pool.size() / 2) this->compact();
+        size_t capacity = std::max(minCapacity, 2 * span.capacity);
+        // A list already at the end of the pool grows in place.
+        if(span.offset + span.capacity == pool.size()){
+          pool.resize(span.offset + capacity);
+          span.capacity = capacity;
+          return;
+        }
+        size_t offset = pool.size();
+        pool.resize(offset + capacity);
+        std::copy(pool.begin() + span.offset, pool.begin() + span.offset + span.length, pool.begin() + offset);
+        nbOfHoles += span.capacity;
+        span.offset = offset;
+        span.capacity = capacity;
+      }
+
+      // Packs all lists in list order, each with a capacity equal to its length.
+      void compact(){
+        std::vector<Index_t> packed;
+        packed.reserve(pool.size() - nbOfHoles);
+        for(size_t i = 0; i < spans.size(); i++){
+          Span& span = spans[i];
+          size_t offset = packed.size();
+          packed.insert(packed.end(), pool.begin() + span.offset, pool.begin() + span.offset + span.length);
+          span.offset = offset;
+          span.capacity = span.length;
+        }
+        pool.swap(packed);
+        nbOfHoles = 0;
+      }
+
+      std::vector<Index_t> pool;
+      std::vector<Span> spans;
+      size_t nbOfHoles;
+    };
+
+    std::vector<CowPointer<Block> > _blocks;
+    size_t _nbOfLists;
+
+    // Expected number of indices per list, used to size the pools of new blocks (see reserve()).
+    size_t _indicesPerList;
+};
+
+#endif /* RNN_ADJACENCYARENA_HPP_ */
@@ -0,0 +1,107 @@
+/*
+ * RNN_BatchState.hpp
+ *
+ * Revision: October 2026
+ *
+ * The activation state of several independent sequences run through the same network.
+ */
+
+#ifndef RNN_BATCHSTATE_HPP_
+#define RNN_BATCHSTATE_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Activation values and incoming potentials of B independent sequences.
+// The state is a neurons x B matrix stored row by row, so the B values of one neuron are contiguous.
+template<typename Scalar_t = double>
+class BasicBatchState{
+  public:
+    typedef Scalar_t scalar_t;
+
+    // Constructor. Creates a zeroed state for the indicated number of neurons and sequences.
+    BasicBatchState(size_t nbOfNeurons = 0, size_t batchSize = 1):
+      _nbOfNeurons(nbOfNeurons),
+      _batchSize(batchSize),
+      _values(nbOfNeurons * batchSize, Scalar_t(0)),
+      _incoming(nbOfNeurons * batchSize, Scalar_t(0)),
+      _scratch(2 * batchSize, Scalar_t(0)){
+    }
+
+    // Returns the number of neurons.
+    size_t size() const{
+      return _nbOfNeurons;
+    }
+
+    // Returns the number of sequences.
+    size_t getBatchSize() const{
+      return _batchSize;
+    }
+
+    // Changes the number of neurons, keeping the state of existing neurons. New neurons start at zero.
+    void resize(size_t nbOfNeurons){
+      _nbOfNeurons = nbOfNeurons;
+      _values.resize(nbOfNeurons * _batchSize, Scalar_t(0));
+      _incoming.resize(nbOfNeurons * _batchSize, Scalar_t(0));
+    }
+
+    // Returns the activation value of the indicated neuron in the indicated sequence.
+    Scalar_t getValue(size_t neuronIndex, size_t sequence) const{
+      return _values[neuronIndex * _batchSize + sequence];
+    }
+
+    // Sets the activation value of the indicated neuron in the indicated sequence.
+    void setValue(size_t neuronIndex, size_t sequence, Scalar_t value){
+      _values[neuronIndex * _batchSize + sequence] = value;
+    }
+
+    // Sets the activation value of the indicated neuron in every sequence.
+    void setValue(size_t neuronIndex, Scalar_t value){
+      std::fill(this->getValues(neuronIndex), this->getValues(neuronIndex) + _batchSize, value);
+    }
+
+    // Returns the incoming potential of the indicated neuron in the indicated sequence.
+    Scalar_t getIncoming(size_t neuronIndex, size_t sequence) const{
+      return _incoming[neuronIndex * _batchSize + sequence];
+    }
+
+    // Returns the activation values of the indicated neuron in all sequences.
+    Scalar_t* getValues(size_t neuronIndex){
+      return _values.data() + neuronIndex * _batchSize;
+    }
+
+    // Returns the activation values of the indicated neuron in all sequences.
+    const Scalar_t* getValues(size_t neuronIndex) const{
+      return _values.data() + neuronIndex * _batchSize;
+    }
+
+    // Returns the incoming potentials of the indicated neuron in all sequences.
+    Scalar_t* getIncomingValues(size_t neuronIndex){
+      return _incoming.data() + neuronIndex * _batchSize;
+    }
+
+    // Returns a scratch buffer of 2 x B values used while propagating one neuron.
+    Scalar_t* getScratch(){
+      return _scratch.data();
+    }
+
+    // Resets every sequence.
+    void reset(){
+      std::fill(_values.begin(), _values.end(), Scalar_t(0));
+      std::fill(_incoming.begin(), _incoming.end(), Scalar_t(0));
+    }
+
+  protected:
+    size_t _nbOfNeurons;
+    size_t _batchSize;
+    std::vector<Scalar_t> _values;
+    std::vector<Scalar_t> _incoming;
+    std::vector<Scalar_t> _scratch;
+};
+
+// The default batch state, with double precision values.
+typedef BasicBatchState<double> BatchState;
+
+#endif /* RNN_BATCHSTATE_HPP_ */
@@ -0,0 +1,224 @@
+/*
+ * RNN_Checkpoint.hpp
+ *
+ * Revision: October 2026
+ *
+ * Checkpoints of networks and populations, written atomically and optionally in the background.
+ *
+ * Layout (native byte order): magic "RNNS", version, then the state written by the writeState() method of the
+ * checkpointed object (NeuralNetwork or Population).
+ */
+
+#ifndef RNN_CHECKPOINT_HPP_
+#define RNN_CHECKPOINT_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RNN_CHECKPOINT_FSYNC 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Local libraries
+#include "Misc_BinaryStream.hpp"
+#include "RNN_NeuralNetwork.hpp"
+#include "RNN_Population.hpp"
+
+// Reads and writes checkpoint files.
+// A checkpoint is first written to fileName + ".tmp", flushed to disk and then renamed over the previous one, and
+// the rename is flushed as well, so the file always holds a complete checkpoint, even if the system crashes.
+class CheckpointFile{
+  public:
+    // Function writing the state of an object to a stream.
+    typedef std::function<bool(std::ostream&)> writer_t;
+
+    // Current version of the format.
+    static constexpr uint32_t version = 1;
+
+    // Writes the state of the supplied network or population to the indicated file. Returns false on failure.
+    template<typename Object_t>
+    static bool save(const std::string& fileName, Object_t& object){
+      return write([&object](std::ostream& output){ return object.writeState(output); }, fileName);
+    }
+
+    // Replaces the state of the supplied network or population with the one stored in the indicated file.
+    // Returns false, leaving the object unchanged, on failure.
+    template<typename Object_t>
+    static bool load(const std::string& fileName, Object_t& object){
+      std::ifstream file(fileName.c_str(), std::ios::binary);
+      if(!file.is_open()){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+        return false;
+      }
+      char magic[4];
+      uint32_t fileVersion;
+      if(!file.read(magic, 4) || std::memcmp(magic, "RNNS", 4) != 0){
+        std::cerr << "Not a checkpoint file: " << fileName << std::endl;
+        return false;
+      }
+      if(!readBinary(file, fileVersion) || fileVersion != version){
+        std::cerr << "Unsupported checkpoint file version " << fileVersion << ": " << fileName << std::endl;
+        return false;
+      }
+      if(!object.readState(file)) return false;
+      if(file.peek() != std::char_traits<char>::eof()){
+        std::cerr << "Trailing data in checkpoint file: " << fileName << std::endl;
+        return false;
+      }
+      return true;
+    }
+
+    // Writes a checkpoint with the supplied function to the indicated file, atomically. Returns false on failure.
+    // The temporary file is flushed to disk before the rename, and the directory after it, so that neither the
+    // contents nor the rename can be lost in a crash.
+    static bool write(const writer_t& writer, const std::string& fileName){
+      std::string temporaryName = fileName + ".tmp";
+      {
+        std::ofstream file(temporaryName.c_str(), std::ios::binary | std::ios::trunc);
+        if(!file.is_open()){
+          std::cerr << "Could not open file: " << temporaryName << std::endl;
+          return false;
+        }
+        file.write("RNNS", 4);
+        writeBinary(file, version);
+        if(!writer(file) || !file.flush()){
+          std::cerr << "Could not write checkpoint: " << temporaryName << std::endl;
+          return false;
+        }
+      }
+#ifdef RNN_CHECKPOINT_FSYNC
+      int descriptor = ::open(temporaryName.c_str(), O_RDONLY);
+      if(descriptor < 0 || ::fsync(descriptor) != 0){
+        std::cerr << "Could not flush checkpoint: " << temporaryName << std::endl;
+        if(descriptor >= 0) ::close(descriptor);
+        return false;
+      }
+      ::close(descriptor);
+#endif
+      if(std::rename(temporaryName.c_str(), fileName.c_str()) != 0){
+        std::cerr << "Could not replace checkpoint: " << fileName << std::endl;
+        return false;
+      }
+#ifdef RNN_CHECKPOINT_FSYNC
+      size_t separator = fileName.find_last_of('/');
+      std::string directoryName = separator == std::string::npos ? "." : fileName.substr(0, std::max<size_t>(separator, 1));
+      descriptor = ::open(directoryName.c_str(), O_RDONLY);
+      if(descriptor < 0 || ::fsync(descriptor) != 0){
+        std::cerr << "Could not flush directory: " << directoryName << std::endl;
+        if(descriptor >= 0) ::close(descriptor);
+        return false;
+      }
+      ::close(descriptor);
+#endif
+      return true;
+    }
+};
+
+// Writes checkpoints of a network or population to one file on a background thread.
+// write() takes a snapshot that shares the storage of the object, which costs one pass over the neurons to copy the
+// activation state, and returns; the step loop continues while the snapshot is written. If the previous snapshot is
+// still being written when write() is called again, the newer one replaces any snapshot not started yet.
+class CheckpointWriter{
+  public:
+    // Constructor. Starts the thread writing checkpoints to the indicated file.
+    explicit CheckpointWriter(const std::string& fileName):
+      _fileName(fileName),
+      _hasPending(false),
+      _writing(false),
+      _stop(false),
+      _succeeded(true),
+      _nbOfWrites(0){
+      _thread = std::thread(&CheckpointWriter::writerLoop, this);
+    }
+
+    // Destructor. Writes the pending snapshot, if any, and stops the thread.
+    ~CheckpointWriter(){
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _wake.notify_all();
+      _thread.join();
+    }
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Schedules a checkpoint of the supplied network or population, taken now, and returns without waiting.
+    template<typename Object_t>
+    void write(Object_t& object){
+      auto snapshot = object.snapshot();
+      CheckpointFile::writer_t writer = [snapshot](std::ostream& output) mutable{ return snapshot.writeState(output); };
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.swap(writer);
+        _hasPending = true;
+      }
+      _wake.notify_all();
+    }
+
+    // Waits until every scheduled checkpoint is written. Returns false if the last one failed.
+    bool wait(){
+      std::unique_lock<std::mutex> lock(_mutex);
+      _idle.wait(lock, [this]{ return !_hasPending && !_writing; });
+      return _succeeded;
+    }
+
+    // Returns the number of checkpoints written so far.
+    size_t getNbOfWrites(){
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _nbOfWrites;
+    }
+
+  protected:
+    // Main loop of the writing thread.
+    void writerLoop(){
+      std::unique_lock<std::mutex> lock(_mutex);
+      while(true){
+        _wake.wait(lock, [this]{ return _hasPending || _stop; });
+        if(!_hasPending) return;
+        CheckpointFile::writer_t writer;
+        writer.swap(_pending);
+        _hasPending = false;
+        _writing = true;
+        lock.unlock();
+        bool succeeded = CheckpointFile::write(writer, _fileName);
+        // The snapshot is released outside the lock.
+        writer = CheckpointFile::writer_t();
+        lock.lock();
+        _writing = false;
+        _succeeded = succeeded;
+        if(succeeded) _nbOfWrites++;
+        _idle.notify_all();
+      }
+    }
+
+    std::string _fileName;
+
+    // The snapshot waiting to be written, and the state of the writing thread (guarded by _mutex).
+    CheckpointFile::writer_t _pending;
+    bool _hasPending;
+    bool _writing;
+    bool _stop;
+    bool _succeeded;
+    size_t _nbOfWrites;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::thread _thread;
+};
+
+#endif /* RNN_CHECKPOINT_HPP_ */
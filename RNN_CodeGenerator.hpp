@@ -0,0 +1,274 @@
+/*
+ * RNN_CodeGenerator.hpp
+ *
+ * Revision: October 2026
+ *
+ * Exports a network to a standalone C++ kernel with a plain C interface.
+ *
+ * For a kernel named "controller", generate() writes three files:
+ * - controller.hpp: the C interface (controller_state, controller_reset(), controller_set_input(),
+ *   controller_step(), controller_get_output() and controller_get_value())
+ * - controller.cpp: the kernel, with hard-coded weights, biases and lambdas and a straight-line update step
+ * - controller_test.cpp: a harness that runs the kernel next to NeuralNetwork::update() and checks that every
+ *   value matches after every step
+ *
+ * The kernel depends on <cmath> only. The harness also needs the headers of this library:
+ *   g++ -std=c++17 -O2 controller.cpp -c
+ *   g++ -std=c++17 -O2 -I<library> controller.cpp controller_test.cpp -o controller_test -pthread
+ *   ./controller_test [network_file] [steps]
+ * Weights are written as hexadecimal floating-point literals and every sum keeps the order of the execution plan,
+ * so the kernel is bit-identical to update() as long as both are compiled without floating-point contraction
+ * (the default in ISO C++ mode; GNU mode needs -ffp-contract=off).
+ */
+
+#ifndef RNN_CODEGENERATOR_HPP_
+#define RNN_CODEGENERATOR_HPP_
+
+// Standard libraries
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Local libraries
+#include "RNN_NetworkFile.hpp"
+#include "RNN_NeuralNetwork.hpp"
+
+// Writes the source code of a kernel that performs the update step of a given network.
+// The kernel always computes in double precision, whatever the scalar type of the network.
+class CodeGenerator{
+  public:
+    // Writes <baseName>.hpp, <baseName>.cpp and <baseName>_test.cpp for the supplied network.
+    // The functions of the kernel are prefixed with the supplied name, which must be a C identifier.
+    // The harness loads the indicated network file unless it is given another one on the command line.
+    // Returns false if the name is invalid, if the execution plan of the network leaves pruned neurons out (see
+    // NeuralNetwork::setOutputOnly()), since the kernel computes every neuron, or if a file cannot be written.
+    template<typename Neuron_t, typename Connection_t>
+    static bool generate(NeuralNetwork<Neuron_t, Connection_t>& network, const std::string& baseName, const std::string& name,
+                         const std::string& networkFileName = ""){
+      if(!isIdentifier(name)){
+        std::cerr << "Invalid kernel name: " << name << std::endl;
+        return false;
+      }
+      const typename NeuralNetwork<Neuron_t, Connection_t>::plan_t& plan = network.getExecutionPlan();
+      size_t nbOfNeurons = plan.size();
+      if(plan.getNbOfComputedNeurons() != nbOfNeurons){
+        std::cerr << "Network prunes " << nbOfNeurons - plan.getNbOfComputedNeurons()
+                  << " neurons; generate the kernel with setOutputOnly(false)" << std::endl;
+        return false;
+      }
+      std::string includeName = fileName(baseName) + ".hpp";
+
+      std::ofstream header((baseName + ".hpp").c_str());
+      writeHeader(header, name, network.getInputs(), network.getOutputs(), nbOfNeurons, plan.nbOfConnections());
+      if(!header){
+        std::cerr << "Cannot write file: " << baseName << ".hpp" << std::endl;
+        return false;
+      }
+
+      std::ofstream source((baseName + ".cpp").c_str());
+      source << "// Generated by RNN_CodeGenerator.hpp. Do not edit.\n\n";
+      source << "#include <cmath>\n#include <cstring>\n\n#include \"" << includeName << "\"\n\n";
+      source << "// Activation functions, as in NeuronBase::activate().\n";
+      source << "static inline double linear(double x){\n  return x > 1.0 ? 1.0 : (x < -1.0 ? -1.0 : x);\n}\n\n";
+      source << "static inline double gaussian(double x){\n  return std::exp(-x*x) * 2.0 - 1.0;\n}\n\n";
+      source << "void " << name << "_reset(" << name << "_state* state){\n";
+      source << "  std::memset(state->values, 0, sizeof(state->values));\n}\n\n";
+      source << "void " << name << "_set_input(" << name << "_state* state, size_t index, double value){\n";
+      source << "  state->values[index] = value;\n}\n\n";
+      source << "double " << name << "_get_output(const " << name << "_state* state, size_t index){\n";
+      source << "  return state->values[" << network.getInputs() << " + index];\n}\n\n";
+      source << "double " << name << "_get_value(const " << name << "_state* state, size_t index){\n";
+      source << "  return state->values[index];\n}\n\n";
+      source << "void " << name << "_step(" << name << "_state* state){\n";
+      source << "  const double* v = state->values;\n";
+      source << "  double x[" << (nbOfNeurons > 0 ? nbOfNeurons : 1) << "];\n";
+      source << "  // Incoming potentials.\n";
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        source << "  x[" << i << "] = 0.0";
+        for(size_t j = plan.getOffsets()[i]; j < plan.getOffsets()[i + 1]; j++){
+          source << " + v[" << plan.getSources()[j] << "] * " << literal(double(plan.getWeights()[j]));
+        }
+        source << ";\n";
+      }
+      source << "  // Activations.\n";
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        source << "  state->values[" << i << "] = "
+               << activation(plan.getActivationFunctions()[i], "(x[" + std::to_string(i) + "] + " + literal(double(plan.getBiases()[i])) + ")",
+                             double(plan.getLambdas()[i])) << ";\n";
+      }
+      source << "}\n";
+      if(!source){
+        std::cerr << "Cannot write file: " << baseName << ".cpp" << std::endl;
+        return false;
+      }
+
+      std::ofstream harness((baseName + "_test.cpp").c_str());
+      writeHarness(harness, name, includeName, networkFileName);
+      if(!harness){
+        std::cerr << "Cannot write file: " << baseName << "_test.cpp" << std::endl;
+        return false;
+      }
+      return true;
+    }
+
+    // Replaces the supplied network with the one stored in the indicated file.
+    // The file is either a binary network file (see RNN_NetworkFile.hpp) or text written with operator<<.
+    // Returns false on failure.
+    template<typename Neuron_t, typename Connection_t>
+    static bool load(const std::string& fileName, NeuralNetwork<Neuron_t, Connection_t>& network){
+      std::ifstream file(fileName.c_str(), std::ios::binary);
+      if(!file){
+        std::cerr << "Cannot open file: " << fileName << std::endl;
+        return false;
+      }
+      char magic[4] = {0, 0, 0, 0};
+      file.read(magic, 4);
+      if(file.gcount() == 4 && std::memcmp(magic, "RNNB", 4) == 0){
+        return NetworkFile::load(fileName, network);
+      }
+      file.clear();
+      file.seekg(0);
+      if(!(file >> network)){
+        std::cerr << "Not a network file: " << fileName << std::endl;
+        return false;
+      }
+      return true;
+    }
+
+  protected:
+    // Returns true if the supplied name is a C identifier.
+    static bool isIdentifier(const std::string& name){
+      if(name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) return false;
+      for(size_t i = 0; i < name.size(); i++){
+        if(!std::isalnum(static_cast<unsigned char>(name[i])) && name[i] != '_') return false;
+      }
+      return true;
+    }
+
+    // Returns the supplied path without its directory.
+    static std::string fileName(const std::string& path){
+      size_t slash = path.find_last_of("/\\");
+      return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    // Returns a C++ literal holding exactly the supplied value.
+    static std::string literal(double value){
+      if(value != value) return "NAN";
+      if(std::isinf(value)) return value < 0 ? "(-INFINITY)" : "INFINITY";
+      char buffer[64];
+      std::snprintf(buffer, sizeof(buffer), value < 0 ? "(%a)" : "%a", value);
+      return buffer;
+    }
+
+    // Returns the expression of the indicated activation function applied to x.
+    static std::string activation(Neuron::af_t activation, const std::string& x, double lambda){
+      switch(activation){
+        case Neuron::linear:
+          return "linear" + x;
+        case Neuron::sine:
+          return "std::sin" + x;
+        case Neuron::gaussian:
+          return "gaussian" + x;
+        case Neuron::sigmoid:
+          return "std::tanh(" + x + " * " + literal(lambda) + ")";
+        default:
+          return "0.0";
+      }
+    }
+
+    // Writes the C interface of a kernel.
+    static void writeHeader(std::ostream& output, const std::string& name, size_t nbOfInputs, size_t nbOfOutputs,
+                            size_t nbOfNeurons, size_t nbOfConnections){
+      std::string guard = upper(name) + "_HPP_";
+      std::string prefix = upper(name);
+      output << "// Generated by RNN_CodeGenerator.hpp. Do not edit.\n";
+      output << "// Network with " << nbOfInputs << " inputs, " << nbOfOutputs << " outputs, " << nbOfNeurons << " neurons and "
+             << nbOfConnections << " connections.\n\n";
+      output << "#ifndef " << guard << "\n#define " << guard << "\n\n#include <stddef.h>\n\n";
+      output << "#define " << prefix << "_NB_INPUTS " << nbOfInputs << "\n";
+      output << "#define " << prefix << "_NB_OUTPUTS " << nbOfOutputs << "\n";
+      output << "#define " << prefix << "_NB_NEURONS " << nbOfNeurons << "\n\n";
+      output << "#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n";
+      output << "// Activation values of all neurons: inputs first, then outputs, then hidden neurons.\n";
+      output << "typedef struct " << name << "_state{\n  double values[" << (nbOfNeurons > 0 ? nbOfNeurons : 1) << "];\n} "
+             << name << "_state;\n\n";
+      output << "// Sets all activation values to zero.\n";
+      output << "void " << name << "_reset(" << name << "_state* state);\n\n";
+      output << "// Sets the activation value of the indicated input neuron.\n";
+      output << "void " << name << "_set_input(" << name << "_state* state, size_t index, double value);\n\n";
+      output << "// Performs one update of network activation.\n";
+      output << "void " << name << "_step(" << name << "_state* state);\n\n";
+      output << "// Returns the activation value of the indicated output neuron.\n";
+      output << "double " << name << "_get_output(const " << name << "_state* state, size_t index);\n\n";
+      output << "// Returns the activation value of the indicated neuron.\n";
+      output << "double " << name << "_get_value(const " << name << "_state* state, size_t index);\n\n";
+      output << "#ifdef __cplusplus\n}\n#endif\n\n#endif\n";
+    }
+
+    // Writes the harness that checks a kernel against NeuralNetwork::update().
+    static void writeHarness(std::ostream& output, const std::string& name, const std::string& includeName,
+                             const std::string& networkFileName){
+      output << "// Generated by RNN_CodeGenerator.hpp. Do not edit.\n";
+      output << "// Checks " << name << "_step() against NeuralNetwork::update() with random inputs.\n";
+      output << "// Usage: ./" << name << "_test [network_file] [steps]\n\n";
+      output << "#include <cstdlib>\n#include <iostream>\n#include <string>\n\n";
+      output << "#include \"RNN_CodeGenerator.hpp\"\n#include \"RNN_NeuralNetwork.hpp\"\n#include \"Misc_Random.hpp\"\n\n";
+      output << "#include \"" << includeName << "\"\n\n";
+      output << "int main(int argc, char* argv[]) {\n";
+      output << "    std::string networkFileName = argc > 1 ? argv[1] : \"" << escape(networkFileName) << "\";\n";
+      output << "    size_t steps = argc > 2 ? size_t(atol(argv[2])) : 1000;\n\n";
+      output << "    NeuralNetwork<> network;\n";
+      output << "    if(!CodeGenerator::load(networkFileName, network)) return 1;\n";
+      output << "    if(network.getNbOfNeurons() != " << upper(name) << "_NB_NEURONS || network.getInputs() != "
+             << upper(name) << "_NB_INPUTS){\n";
+      output << "      std::cerr << \"Network does not match the kernel: \" << networkFileName << std::endl;\n";
+      output << "      return 1;\n    }\n\n";
+      output << "    " << name << "_state state;\n";
+      output << "    " << name << "_reset(&state);\n";
+      output << "    network.reset();\n";
+      output << "    generator().seed(1);\n";
+      output << "    size_t mismatches = 0;\n";
+      output << "    for(size_t step = 0; step < steps; step++){\n";
+      output << "      for(size_t i = 0; i < network.getInputs(); i++){\n";
+      output << "        double value = randDouble(-1.0, 1.0);\n";
+      output << "        network.setValue(i, value);\n";
+      output << "        " << name << "_set_input(&state, i, value);\n";
+      output << "      }\n";
+      output << "      network.update();\n";
+      output << "      " << name << "_step(&state);\n";
+      output << "      for(size_t i = 0; i < network.getNbOfNeurons(); i++){\n";
+      output << "        double expected = network.getValue(i);\n";
+      output << "        double actual = " << name << "_get_value(&state, i);\n";
+      output << "        if(expected != actual && !(expected != expected && actual != actual)){\n";
+      output << "          if(mismatches++ < 10){\n";
+      output << "            std::cerr << \"Step \" << step << \", neuron \" << i << \": \" << actual << \" instead of \" << expected << std::endl;\n";
+      output << "          }\n        }\n      }\n    }\n\n";
+      output << "    std::cout << steps << \" steps, \" << mismatches << \" mismatches\" << std::endl;\n";
+      output << "    return mismatches == 0 ? 0 : 1;\n}\n";
+    }
+
+    // Returns the supplied name in upper case.
+    static std::string upper(const std::string& name){
+      std::string result = name;
+      for(size_t i = 0; i < result.size(); i++){
+        result[i] = char(std::toupper(static_cast<unsigned char>(result[i])));
+      }
+      return result;
+    }
+
+    // Returns the supplied text as the contents of a C++ string literal.
+    static std::string escape(const std::string& text){
+      std::string result;
+      for(size_t i = 0; i < text.size(); i++){
+        if(text[i] == '"' || text[i] == '\\') result += '\\';
+        result += text[i];
+      }
+      return result;
+    }
+};
+
+#endif /* RNN_CODEGENERATOR_HPP_ */
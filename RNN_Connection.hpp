@@ -8,41 +8,64 @@
 #ifndef RNN_CONNECTION_HPP_
 #define RNN_CONNECTION_HPP_
 
+// Standard libraries
+#include <cstddef>
+
 // A connection class for neural networks.
-class Connection{
+// The weight is stored as Scalar_t and the source and target neuron indices as Index_t,
+// so that for example float weights with uint32_t indices take 12 bytes per connection.
+template<typename Scalar_t = double, typename Index_t = size_t>
+class BasicConnection{
   public:
+    typedef Scalar_t scalar_t;
+    typedef Index_t index_t;
+
     // Constructor. Creates a new connection in the nerual network.
     // Sets the source, target, weight of this connection.
-    Connection(size_t source, size_t target, double weight):
-      _source(source),
-      _target(target),
+    BasicConnection(size_t source, size_t target, Scalar_t weight):
+      _source(Index_t(source)),
+      _target(Index_t(target)),
       _weight(weight){
     }
 
     // Returns the weight of this connection.
-    const double& getWeight(){
+    const Scalar_t& getWeight() const{
       return _weight;
     }
 
     // Sets the weight of this connection.
-    void setWeight(double weight){
+    void setWeight(Scalar_t weight){
       _weight = weight;
     }
 
     // Returns the source of this connection.
-    const size_t& getSource(){
+    const Index_t& getSource() const{
       return _source;
     }
 
     // Returns the target of this connection.
-    const size_t& getTarget(){
+    const Index_t& getTarget() const{
       return _target;
     }
 
+    // Returns false if this connection has been removed from its network.
+    bool isAlive() const{
+      return _source != Index_t(-1);
+    }
+
+    // Marks this connection as removed. Its storage may later be reused by another connection.
+    void kill(){
+      _source = Index_t(-1);
+      _target = Index_t(-1);
+    }
+
   protected:
-    size_t _source;
-    size_t _target;
-    double _weight;
+    Index_t _source;
+    Index_t _target;
+    Scalar_t _weight;
 };
 
+// The default connection, with a double precision weight and size_t neuron indices.
+typedef BasicConnection<double, size_t> Connection;
+
 #endif /* RNN_CONNECTION_HPP_ */
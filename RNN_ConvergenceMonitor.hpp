@@ -0,0 +1,222 @@
+/*
+ * RNN_ConvergenceMonitor.hpp
+ *
+ * Revision: October 2026
+ *
+ * Detection of fixed points and limit cycles of the network activation.
+ */
+
+#ifndef RNN_CONVERGENCEMONITOR_HPP_
+#define RNN_CONVERGENCEMONITOR_HPP_
+
+// Standard libraries
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Watches the sequence of activation states of a network and detects when it repeats.
+// The last maxPeriod + 1 states are kept; a state equal to the one k steps earlier is a fixed point (k = 1)
+// or a cycle of period k. States are compared after rounding every value to a multiple of the quantum,
+// or bit for bit with a quantum of zero; a hash of every state makes the comparison with non-matching
+// states cheap. After a detection, NeuralNetwork::run() either stops or fast-forwards to the state the
+// remaining steps would reach.
+class ConvergenceMonitor{
+  public:
+    // Outcome of the observed steps.
+    enum status_t{
+      running,
+      fixedPoint,
+      limitCycle
+    };
+
+    // What run() does after a detection.
+    enum action_t{
+      stop,
+      fastForward
+    };
+
+    // Constructor. Detects cycles up to the indicated period, comparing values rounded to the indicated quantum.
+    ConvergenceMonitor(size_t maxPeriod = 16, double quantum = 0.0, action_t action = stop):
+      _maxPeriod(maxPeriod > 0 ? maxPeriod : 1),
+      _quantum(quantum),
+      _action(action),
+      _nbOfNeurons(0){
+      this->reset();
+    }
+
+    // Forgets all observed states and the outcome.
+    void reset(){
+      this->clearHistory();
+      _steps = 0;
+      _skippedSteps = 0;
+    }
+
+    // Forgets the observed states, for example after the network changed, keeping the step count.
+    void clearHistory(){
+      _status = running;
+      _period = 0;
+      _detectionStep = 0;
+      _nbOfStates = 0;
+      _next = 0;
+      _hashes.assign(_maxPeriod + 1, 0);
+    }
+
+    // Records the state after one more step and returns the status.
+    // Once a fixed point or cycle is detected, the status is kept until the history is cleared.
+    template<typename Scalar_t>
+    status_t observe(const Scalar_t* values, const Scalar_t* incoming, size_t nbOfNeurons){
+      _steps++;
+      if(_status != running) return _status;
+      if(nbOfNeurons != _nbOfNeurons){
+        _nbOfNeurons = nbOfNeurons;
+        _values.assign((_maxPeriod + 1) * nbOfNeurons, 0.0);
+        _incoming.assign((_maxPeriod + 1) * nbOfNeurons, 0.0);
+        this->clearHistory();
+      }
+      double* stateValues = &_values[_next * nbOfNeurons];
+      double* stateIncoming = &_incoming[_next * nbOfNeurons];
+      uint64_t hash = 14695981039346656037ULL;
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        stateValues[i] = double(values[i]);
+        stateIncoming[i] = double(incoming[i]);
+        hash = (hash ^ this->key(stateValues[i])) * 1099511628211ULL;
+      }
+      _hashes[_next] = hash;
+      for(size_t period = 1; period <= _maxPeriod && period <= _nbOfStates; period++){
+        size_t earlier = this->position(period);
+        if(_hashes[earlier] == hash && this->equal(stateValues, &_values[earlier * nbOfNeurons])){
+          _status = period == 1 ? fixedPoint : limitCycle;
+          _period = period;
+          _detectionStep = _steps;
+          break;
+        }
+      }
+      _next = (_next + 1) % (_maxPeriod + 1);
+      if(_nbOfStates < _maxPeriod) _nbOfStates++;
+      return _status;
+    }
+
+    // Returns the activation values the network will have after the indicated number of further steps,
+    // assuming the detected fixed point or cycle continues.
+    const double* getValues(size_t stepsAhead) const{
+      return &_values[this->phase(stepsAhead) * _nbOfNeurons];
+    }
+
+    // Returns the incoming potentials the network will have after the indicated number of further steps.
+    const double* getIncomingValues(size_t stepsAhead) const{
+      return &_incoming[this->phase(stepsAhead) * _nbOfNeurons];
+    }
+
+    // Records the number of steps skipped by fast-forwarding.
+    void setSkippedSteps(size_t skippedSteps){
+      _skippedSteps = skippedSteps;
+    }
+
+    // Returns the outcome of the observed steps.
+    status_t getStatus() const{
+      return _status;
+    }
+
+    // Returns the period of the detected cycle (1 for a fixed point), or 0.
+    size_t getPeriod() const{
+      return _period;
+    }
+
+    // Returns the number of steps observed when the fixed point or cycle was detected, or 0.
+    size_t getDetectionStep() const{
+      return _detectionStep;
+    }
+
+    // Returns the number of steps observed since the last reset.
+    size_t getNbOfSteps() const{
+      return _steps;
+    }
+
+    // Returns the number of steps skipped by fast-forwarding.
+    size_t getSkippedSteps() const{
+      return _skippedSteps;
+    }
+
+    // Returns what run() does after a detection.
+    action_t getAction() const{
+      return _action;
+    }
+
+    // Sets what run() does after a detection.
+    void setAction(action_t action){
+      _action = action;
+    }
+
+    // Returns the name of a status.
+    static const char* getName(status_t status){
+      static const char* names[3] = {"running", "fixed_point", "limit_cycle"};
+      return names[status];
+    }
+
+    // Writes the outcome of the observed steps.
+    void report(std::ostream& output) const{
+      output << getName(_status);
+      if(_status != running) output << " period " << _period << " detected at step " << _detectionStep;
+      output << ", " << _steps << " steps run, " << _skippedSteps << " steps skipped" << std::endl;
+    }
+
+  protected:
+    // Returns the position in the history of the state the indicated number of steps before the newest one.
+    // Must be called before _next is advanced past the newest state.
+    size_t position(size_t stepsBack) const{
+      return (_next + _maxPeriod + 1 - stepsBack) % (_maxPeriod + 1);
+    }
+
+    // Returns the position in the history of the state reached after the indicated number of further steps.
+    size_t phase(size_t stepsAhead) const{
+      // The newest state sits just before _next and repeats every _period steps.
+      size_t newest = (_next + _maxPeriod) % (_maxPeriod + 1);
+      size_t back = _period - stepsAhead % _period;
+      if(back == _period) return newest;
+      return (newest + _maxPeriod + 1 - back) % (_maxPeriod + 1);
+    }
+
+    // Returns the comparison key of a value: the multiple of the quantum nearest to it, or its bits.
+    uint64_t key(double value) const{
+      if(_quantum > 0.0){
+        double scaled = value / _quantum;
+        if(std::fabs(scaled) < 9e18) return uint64_t(std::llround(scaled));
+      }
+      if(value == 0.0) value = 0.0;
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    // Returns true if the supplied states have the same keys.
+    bool equal(const double* a, const double* b) const{
+      for(size_t i = 0; i < _nbOfNeurons; i++){
+        if(this->key(a[i]) != this->key(b[i])) return false;
+      }
+      return true;
+    }
+
+    // Settings.
+    size_t _maxPeriod;
+    double _quantum;
+    action_t _action;
+
+    // Outcome.
+    status_t _status;
+    size_t _period;
+    size_t _steps;
+    size_t _detectionStep;
+    size_t _skippedSteps;
+
+    // The last _maxPeriod + 1 states, as a ring buffer of values, incoming potentials and hashes.
+    size_t _nbOfNeurons;
+    size_t _nbOfStates;
+    size_t _next;
+    std::vector<double> _values;
+    std::vector<double> _incoming;
+    std::vector<uint64_t> _hashes;
+};
+
+#endif /* RNN_CONVERGENCEMONITOR_HPP_ */
@@ -0,0 +1,619 @@
+/*
+ * RNN_ExecutionPlan.hpp
+ *
+ * Revision: October 2026
+ *
+ * A compiled, structure-of-arrays form of a neural network used to run updates.
+ */
+
+#ifndef RNN_EXECUTIONPLAN_HPP_
+#define RNN_EXECUTIONPLAN_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Local libraries
+#include "Misc_WorkerTeam.hpp"
+#include "RNN_Activation.hpp"
+#include "RNN_BatchState.hpp"
+#include "RNN_Instrumentation.hpp"
+#include "RNN_Neuron.hpp"
+
+// A frozen, flat representation of a network topology.
+// The incoming connections of neuron i are stored in compressed sparse row (CSR) form:
+// they are the entries [offsets[i], offsets[i+1]) of the source and weight arrays.
+// Activation values, incoming potentials and neuron parameters are kept in separate arrays.
+// Consecutive neurons sharing an activation function form a segment that is propagated by one batch kernel.
+// Neurons added as not computed keep their state but are left out of every update, e.g. neurons pruned because
+// they cannot reach an output; they are covered by no range or segment and have no incoming connections.
+template<typename Scalar_t = double, typename Index_t = size_t>
+class BasicExecutionPlan{
+  public:
+    // A contiguous range of neurons [begin, end) with the same activation function.
+    struct Segment{
+      size_t begin;
+      size_t end;
+      Neuron::af_t activation;
+    };
+
+    // A contiguous range of computed neurons [begin, end).
+    struct Range{
+      size_t begin;
+      size_t end;
+    };
+
+    // Marks a connection that has no slot in this plan.
+    static constexpr size_t npos = size_t(-1);
+
+    // Minimum number of neurons plus connections per thread of a parallel update.
+    static constexpr size_t minWorkPerThread = 16384;
+
+    // Constructor. Creates an empty plan.
+    BasicExecutionPlan():
+      _nbOfComputed(0),
+      _precision(Activation::exact),
+      _tracking(false){
+      _offsets.push_back(0);
+    }
+
+    // Removes all neurons and connections and reserves room for the indicated sizes.
+    void clear(size_t nbOfNeurons = 0, size_t nbOfConnections = 0){
+      _offsets.clear();
+      _sources.clear();
+      _weights.clear();
+      _values.clear();
+      _incoming.clear();
+      _biases.clear();
+      _lambdas.clear();
+      _activationFunctions.clear();
+      _slots.clear();
+      _aliases.clear();
+      _segments.clear();
+      _ranges.clear();
+      _nbOfComputed = 0;
+      this->stopTracking();
+      _offsets.reserve(nbOfNeurons + 1);
+      _sources.reserve(nbOfConnections);
+      _weights.reserve(nbOfConnections);
+      _values.reserve(nbOfNeurons);
+      _incoming.reserve(nbOfNeurons);
+      _biases.reserve(nbOfNeurons);
+      _lambdas.reserve(nbOfNeurons);
+      _activationFunctions.reserve(nbOfNeurons);
+      _slots.assign(nbOfConnections, npos);
+      _offsets.push_back(0);
+    }
+
+    // Appends a neuron to the plan. Its incoming connections are added with addIncoming().
+    // A neuron that is not computed keeps its value and incoming potential, and must get no incoming connections.
+    void addNeuron(Scalar_t value, Scalar_t incoming, Scalar_t bias, Scalar_t lambda, Neuron::af_t activation, bool computed = true){
+      if(_tracking) this->stopTracking();
+      _values.push_back(value);
+      _incoming.push_back(incoming);
+      _biases.push_back(bias);
+      _lambdas.push_back(lambda);
+      _activationFunctions.push_back(activation);
+      _offsets.push_back(Index_t(_sources.size()));
+      if(!computed) return;
+      _nbOfComputed++;
+      if(!_ranges.empty() && _ranges.back().end == _values.size() - 1){
+        _ranges.back().end = _values.size();
+      }
+      else{
+        Range range = {_values.size() - 1, _values.size()};
+        _ranges.push_back(range);
+      }
+      if(!_segments.empty() && _segments.back().activation == activation && _segments.back().end == _values.size() - 1){
+        _segments.back().end = _values.size();
+      }
+      else{
+        Segment segment = {_values.size() - 1, _values.size(), activation};
+        _segments.push_back(segment);
+      }
+    }
+
+    // Appends an incoming connection to the last added neuron.
+    // The connection index is remembered so that its weight can be changed later.
+    void addIncoming(size_t connectionIndex, size_t source, Scalar_t weight){
+      if(_tracking) this->stopTracking();
+      if(connectionIndex >= _slots.size()){
+        _slots.resize(connectionIndex + 1, npos);
+      }
+      if(_slots[connectionIndex] == npos) _slots[connectionIndex] = _sources.size();
+      else _aliases.push_back(std::make_pair(connectionIndex, _sources.size()));
+      _sources.push_back(Index_t(source));
+      _weights.push_back(weight);
+      _offsets.back() = Index_t(_sources.size());
+    }
+
+    // Returns the number of neurons in this plan.
+    size_t size() const{
+      return _values.size();
+    }
+
+    // Returns the number of connections in this plan.
+    size_t nbOfConnections() const{
+      return _sources.size();
+    }
+
+    // Returns the activation value of the indicated neuron.
+    Scalar_t getValue(size_t neuronIndex) const{
+      return _values[neuronIndex];
+    }
+
+    // Sets the activation value of the indicated neuron.
+    void setValue(size_t neuronIndex, Scalar_t value){
+      _values[neuronIndex] = value;
+      if(_tracking){
+        this->markChanged(neuronIndex);
+        this->markDirty(neuronIndex, false);
+      }
+    }
+
+    // Returns the incoming potential of the indicated neuron.
+    Scalar_t getIncoming(size_t neuronIndex) const{
+      return _incoming[neuronIndex];
+    }
+
+    // Sets the incoming potential of the indicated neuron.
+    void setIncoming(size_t neuronIndex, Scalar_t incoming){
+      _incoming[neuronIndex] = incoming;
+      if(_tracking) this->markDirty(neuronIndex, true);
+    }
+
+    // Sets the bias of the indicated neuron.
+    void setBias(size_t neuronIndex, Scalar_t bias){
+      _biases[neuronIndex] = bias;
+      if(_tracking) this->markDirty(neuronIndex, false);
+    }
+
+    // Sets the weight of the indicated connection of the original network.
+    void setWeight(size_t connectionIndex, Scalar_t weight){
+      if(connectionIndex < _slots.size() && _slots[connectionIndex] != npos){
+        this->setSlotWeight(_slots[connectionIndex], weight);
+      }
+      for(size_t i = 0; i < _aliases.size(); i++){
+        if(_aliases[i].first == connectionIndex) this->setSlotWeight(_aliases[i].second, weight);
+      }
+    }
+
+    // Sets the precision of the activation functions (see Activation::precision_t).
+    // The precision is kept when the plan is cleared.
+    void setPrecision(Activation::precision_t precision){
+      _precision = precision;
+    }
+
+    // Returns the precision of the activation functions.
+    Activation::precision_t getPrecision() const{
+      return _precision;
+    }
+
+    // Returns the CSR row offsets (size() + 1 entries).
+    const std::vector<Index_t>& getOffsets() const{
+      return _offsets;
+    }
+
+    // Returns the source neuron of every connection, ordered by target.
+    const std::vector<Index_t>& getSources() const{
+      return _sources;
+    }
+
+    // Returns the weight of every connection, ordered by target.
+    const std::vector<Scalar_t>& getWeights() const{
+      return _weights;
+    }
+
+    // Returns the activation values of all neurons.
+    const std::vector<Scalar_t>& getValues() const{
+      return _values;
+    }
+
+    // Returns the incoming potentials of all neurons.
+    const std::vector<Scalar_t>& getIncomingValues() const{
+      return _incoming;
+    }
+
+    // Returns the biases of all neurons.
+    const std::vector<Scalar_t>& getBiases() const{
+      return _biases;
+    }
+
+    // Returns the activation functions of all neurons.
+    const std::vector<Neuron::af_t>& getActivationFunctions() const{
+      return _activationFunctions;
+    }
+
+    // Returns the lambda of all neurons.
+    const std::vector<Scalar_t>& getLambdas() const{
+      return _lambdas;
+    }
+
+    // Returns the activation function segments.
+    const std::vector<Segment>& getSegments() const{
+      return _segments;
+    }
+
+    // Returns the ranges of computed neurons.
+    const std::vector<Range>& getRanges() const{
+      return _ranges;
+    }
+
+    // Returns the number of computed neurons.
+    size_t getNbOfComputedNeurons() const{
+      return _nbOfComputed;
+    }
+
+    // Performs one update of network activation.
+    void update(){
+      _tracking = false;
+      this->accumulate();
+      this->propagate();
+    }
+
+    // Performs one update of network activation, recomputing only the neurons whose inputs changed.
+    // Every neuron whose value differs from the value last broadcast to its targets by more than epsilon is broadcast
+    // along its outgoing connections, and only the targets it reaches are propagated.
+    // With epsilon = 0 the targets recompute their incoming potential in full and the result is identical to update().
+    // With epsilon > 0 weight * delta is added to the incoming potential of each target instead, and changes up to
+    // epsilon are held back until they grow larger; the result then approximates update().
+    // When many neurons changed in the previous step a full update is done instead.
+    void updateIncremental(double epsilon = 0.0){
+      if(!_tracking || _changed.size() * denseRatio > _values.size()){
+        this->updateTracked(epsilon);
+        return;
+      }
+      RNN_COUNT(steps, 1);
+      this->broadcast(epsilon);
+      this->accumulateDirty();
+      this->propagateDirty(epsilon);
+    }
+
+    // Performs one update of network activation, splitting the neurons over the threads of the supplied team.
+    // Each thread takes a contiguous range of neurons holding about the same number of incoming connections,
+    // accumulates and propagates it, and writes the new activations to a second value array; the arrays are
+    // swapped once every thread has finished. The result is identical to update().
+    // Networks with less than minWorkPerThread computed neurons plus connections per thread use fewer threads.
+    void update(WorkerTeam& team){
+      size_t work = _nbOfComputed + _sources.size();
+      size_t nbOfThreads = std::min(team.size(), work / minWorkPerThread);
+      if(nbOfThreads <= 1){
+        this->update();
+        return;
+      }
+      RNN_PHASE(accumulation);
+      RNN_COUNT(steps, 1);
+      RNN_COUNT(connectionVisits, _sources.size());
+      _tracking = false;
+      _nextValues.resize(_values.size());
+      this->copyUncomputed(_values.data(), _nextValues.data());
+      team.run([this, nbOfThreads](size_t thread){
+        if(thread >= nbOfThreads) return;
+        size_t begin = this->chunkBoundary(thread, nbOfThreads);
+        size_t end = this->chunkBoundary(thread + 1, nbOfThreads);
+        this->accumulate(begin, end);
+        this->propagate(begin, end, _nextValues.data());
+      });
+      _values.swap(_nextValues);
+    }
+
+    // Computes the incoming potential of every neuron from the current activation values.
+    void accumulate(){
+      RNN_PHASE(accumulation);
+      RNN_COUNT(steps, 1);
+      RNN_COUNT(connectionVisits, _sources.size());
+      this->accumulate(0, _values.size());
+    }
+
+    // Propagates the incoming potential to become the current activation of every neuron.
+    void propagate(){
+      RNN_PHASE(propagation);
+      this->propagate(0, _values.size(), _values.data());
+    }
+
+    // Performs one update of every sequence of the supplied batch state.
+    // Each sequence gives the same result as update() would on a plan holding that sequence's state.
+    void update(BasicBatchState<Scalar_t>& state) const{
+      if(state.size() != this->size()) state.resize(this->size());
+      this->accumulate(state);
+      this->propagate(state);
+    }
+
+    // Computes the incoming potentials of every sequence of the supplied batch state.
+    // Each incoming connection is accumulated as a weighted row of B source values.
+    void accumulate(BasicBatchState<Scalar_t>& state) const{
+      RNN_PHASE(accumulation);
+      size_t batchSize = state.getBatchSize();
+      RNN_COUNT(steps, batchSize);
+      RNN_COUNT(connectionVisits, _sources.size() * batchSize);
+      for(size_t r = 0; r < _ranges.size(); r++){
+        for(size_t i = _ranges[r].begin; i < _ranges[r].end; i++){
+          Scalar_t* incoming = state.getIncomingValues(i);
+          std::fill(incoming, incoming + batchSize, Scalar_t(0));
+          for(size_t j = _offsets[i]; j < _offsets[i + 1]; j++){
+            const Scalar_t* source = state.getValues(_sources[j]);
+            Scalar_t weight = _weights[j];
+            for(size_t k = 0; k < batchSize; k++){
+              incoming[k] += source[k] * weight;
+            }
+          }
+        }
+      }
+    }
+
+    // Propagates each neuron over all sequences of the supplied batch state, broadcasting its bias and lambda.
+    void propagate(BasicBatchState<Scalar_t>& state) const{
+      RNN_PHASE(propagation);
+      size_t batchSize = state.getBatchSize();
+      Scalar_t* bias = state.getScratch();
+      Scalar_t* lambda = bias + batchSize;
+      for(size_t i = 0; i < _segments.size(); i++){
+        const Segment& segment = _segments[i];
+        for(size_t j = segment.begin; j < segment.end; j++){
+          std::fill(bias, bias + batchSize, _biases[j]);
+          std::fill(lambda, lambda + batchSize, _lambdas[j]);
+          Activation::apply(segment.activation, _precision, state.getIncomingValues(j), bias, lambda, state.getValues(j), batchSize);
+        }
+      }
+    }
+
+  protected:
+    // Computes the incoming potential of the computed neurons in [begin, end) from the current activation values.
+    void accumulate(size_t begin, size_t end){
+      // First range that ends after begin.
+      size_t first = std::upper_bound(_ranges.begin(), _ranges.end(), begin,
+                                      [](size_t neuron, const Range& range){ return neuron < range.end; }) - _ranges.begin();
+      for(size_t i = first; i < _ranges.size() && _ranges[i].begin < end; i++){
+        this->accumulateRange(std::max(begin, _ranges[i].begin), std::min(end, _ranges[i].end));
+      }
+    }
+
+    // Computes the incoming potential of the neurons [begin, end) from the current activation values.
+    void accumulateRange(size_t begin, size_t end){
+      const Index_t* offsets = _offsets.data();
+      const Index_t* sources = _sources.data();
+      const Scalar_t* weights = _weights.data();
+      const Scalar_t* values = _values.data();
+      Scalar_t* incoming = _incoming.data();
+      for(size_t i = begin; i < end; i++){
+        Scalar_t sum = Scalar_t(0);
+        for(size_t j = offsets[i]; j < offsets[i + 1]; j++){
+          sum += values[sources[j]] * weights[j];
+        }
+        incoming[i] = sum;
+      }
+    }
+
+    // Propagates the incoming potential of the neurons [begin, end), writing their activations to the supplied array.
+    void propagate(size_t begin, size_t end, Scalar_t* values){
+      // First segment that ends after begin.
+      size_t first = std::upper_bound(_segments.begin(), _segments.end(), begin,
+                                      [](size_t neuron, const Segment& segment){ return neuron < segment.end; }) - _segments.begin();
+      for(size_t i = first; i < _segments.size() && _segments[i].begin < end; i++){
+        size_t from = std::max(begin, _segments[i].begin);
+        size_t to = std::min(end, _segments[i].end);
+        Activation::apply(_segments[i].activation, _precision, _incoming.data() + from, _biases.data() + from,
+                          _lambdas.data() + from, values + from, to - from);
+      }
+    }
+
+    // Copies the values of the neurons that are not computed from one value array to the other.
+    void copyUncomputed(const Scalar_t* from, Scalar_t* to) const{
+      size_t begin = 0;
+      for(size_t i = 0; i <= _ranges.size(); i++){
+        size_t end = i < _ranges.size() ? _ranges[i].begin : _values.size();
+        std::copy(from + begin, from + end, to + begin);
+        if(i < _ranges.size()) begin = _ranges[i].end;
+      }
+    }
+
+    // Returns the first neuron of the indicated chunk out of nbOfChunks, balancing neurons plus incoming connections.
+    size_t chunkBoundary(size_t chunk, size_t nbOfChunks) const{
+      size_t nbOfNeurons = _values.size();
+      if(chunk >= nbOfChunks) return nbOfNeurons;
+      size_t target = (nbOfNeurons + _sources.size()) * chunk / nbOfChunks;
+      // Neuron i starts after i neurons and offsets[i] connections.
+      size_t low = 0, high = nbOfNeurons;
+      while(low < high){
+        size_t middle = (low + high) / 2;
+        if(middle + size_t(_offsets[middle]) < target) low = middle + 1;
+        else high = middle;
+      }
+      return low;
+    }
+
+    // Flags of a neuron for the incremental update.
+    enum flag_t{
+      changedFlag = 1,
+      dirtyFlag = 2,
+      recomputeFlag = 4,
+      uncomputedFlag = 8
+    };
+
+    // An incremental update falls back to a full update when more than 1/denseRatio of the neurons changed.
+    static constexpr size_t denseRatio = 4;
+
+    // Sets the weight at the indicated CSR position and schedules its target for recomputation.
+    void setSlotWeight(size_t slot, Scalar_t weight){
+      _weights[slot] = weight;
+      if(_tracking){
+        size_t target = std::upper_bound(_offsets.begin(), _offsets.end(), slot) - _offsets.begin() - 1;
+        this->markDirty(target, true);
+      }
+    }
+
+    // Records that the value of the indicated neuron may differ from the value last broadcast.
+    void markChanged(size_t neuronIndex){
+      if(_flags[neuronIndex] & changedFlag) return;
+      _flags[neuronIndex] |= changedFlag;
+      _changed.push_back(neuronIndex);
+    }
+
+    // Schedules the indicated neuron for propagation, and for recomputation of its incoming potential if requested.
+    void markDirty(size_t neuronIndex, bool recompute){
+      if(_flags[neuronIndex] & uncomputedFlag) return;
+      if(!(_flags[neuronIndex] & dirtyFlag)){
+        _flags[neuronIndex] |= dirtyFlag;
+        _dirty.push_back(neuronIndex);
+      }
+      if(recompute) _flags[neuronIndex] |= recomputeFlag;
+    }
+
+    // Builds the outgoing connections (the transpose of the CSR topology) and starts tracking changes.
+    void startTracking(){
+      size_t nbOfNeurons = _values.size();
+      _outOffsets.assign(nbOfNeurons + 1, 0);
+      _outTargets.resize(_sources.size());
+      _outSlots.resize(_sources.size());
+      for(size_t j = 0; j < _sources.size(); j++){
+        _outOffsets[_sources[j] + 1]++;
+      }
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        _outOffsets[i + 1] += _outOffsets[i];
+      }
+      std::vector<size_t> next(_outOffsets.begin(), _outOffsets.end() - 1);
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        for(size_t j = _offsets[i]; j < _offsets[i + 1]; j++){
+          size_t position = next[_sources[j]]++;
+          _outTargets[position] = Index_t(i);
+          _outSlots[position] = Index_t(j);
+        }
+      }
+      _broadcast.assign(nbOfNeurons, Scalar_t(0));
+      _flags.assign(nbOfNeurons, uncomputedFlag);
+      for(size_t i = 0; i < _ranges.size(); i++){
+        std::fill(_flags.begin() + _ranges[i].begin, _flags.begin() + _ranges[i].end, 0);
+      }
+      _changed.clear();
+      _dirty.clear();
+      _tracking = true;
+    }
+
+    // Stops tracking changes and releases the outgoing connections.
+    void stopTracking(){
+      _tracking = false;
+      _outOffsets.clear();
+      _outTargets.clear();
+      _outSlots.clear();
+      _broadcast.clear();
+      _flags.clear();
+      _changed.clear();
+      _dirty.clear();
+    }
+
+    // Returns true if the value of the indicated neuron differs from its broadcast value by more than epsilon.
+    bool differs(size_t neuronIndex, double epsilon) const{
+      if(epsilon == 0.0) return _values[neuronIndex] != _broadcast[neuronIndex];
+      return !(std::fabs(double(_values[neuronIndex]) - double(_broadcast[neuronIndex])) <= epsilon);
+    }
+
+    // Performs a full update and records which neurons changed.
+    void updateTracked(double epsilon){
+      if(!_tracking) this->startTracking();
+      for(size_t i = 0; i < _changed.size(); i++) _flags[_changed[i]] &= uncomputedFlag;
+      for(size_t i = 0; i < _dirty.size(); i++) _flags[_dirty[i]] &= uncomputedFlag;
+      _changed.clear();
+      _dirty.clear();
+      std::copy(_values.begin(), _values.end(), _broadcast.begin());
+      this->accumulate();
+      this->propagate();
+      for(size_t i = 0; i < _values.size(); i++){
+        if(this->differs(i, epsilon)) this->markChanged(i);
+      }
+    }
+
+    // Sends the change of every changed neuron to its targets.
+    void broadcast(double epsilon){
+      RNN_PHASE(accumulation);
+      for(size_t k = 0; k < _changed.size(); k++){
+        size_t i = _changed[k];
+        _flags[i] &= ~changedFlag;
+        if(!this->differs(i, epsilon)) continue;
+        Scalar_t delta = _values[i] - _broadcast[i];
+        _broadcast[i] = _values[i];
+        RNN_COUNT(connectionVisits, _outOffsets[i + 1] - _outOffsets[i]);
+        for(size_t j = _outOffsets[i]; j < _outOffsets[i + 1]; j++){
+          if(epsilon == 0.0){
+            this->markDirty(_outTargets[j], true);
+          }
+          else{
+            _incoming[_outTargets[j]] += _weights[_outSlots[j]] * delta;
+            this->markDirty(_outTargets[j], false);
+          }
+        }
+      }
+      _changed.clear();
+    }
+
+    // Recomputes the incoming potential of every scheduled neuron from the broadcast values.
+    void accumulateDirty(){
+      RNN_PHASE(accumulation);
+      const Index_t* sources = _sources.data();
+      const Scalar_t* weights = _weights.data();
+      const Scalar_t* values = _broadcast.data();
+      for(size_t k = 0; k < _dirty.size(); k++){
+        size_t i = _dirty[k];
+        if(!(_flags[i] & recomputeFlag)) continue;
+        RNN_COUNT(connectionVisits, _offsets[i + 1] - _offsets[i]);
+        Scalar_t sum = Scalar_t(0);
+        for(size_t j = _offsets[i]; j < _offsets[i + 1]; j++){
+          sum += values[sources[j]] * weights[j];
+        }
+        _incoming[i] = sum;
+      }
+    }
+
+    // Propagates every scheduled neuron and records the ones whose value moved more than epsilon from its broadcast value.
+    void propagateDirty(double epsilon){
+      RNN_PHASE(propagation);
+      for(size_t k = 0; k < _dirty.size(); k++){
+        size_t i = _dirty[k];
+        _flags[i] &= ~(dirtyFlag | recomputeFlag);
+        _values[i] = Activation::activate(_activationFunctions[i], _precision, _incoming[i] + _biases[i], _lambdas[i]);
+        if(this->differs(i, epsilon)) this->markChanged(i);
+      }
+      _dirty.clear();
+    }
+
+    // CSR topology.
+    std::vector<Index_t> _offsets;
+    std::vector<Index_t> _sources;
+    std::vector<Scalar_t> _weights;
+
+    // Neuron state and parameters.
+    std::vector<Scalar_t> _values;
+    std::vector<Scalar_t> _nextValues;
+    std::vector<Scalar_t> _incoming;
+    std::vector<Scalar_t> _biases;
+    std::vector<Scalar_t> _lambdas;
+    std::vector<Neuron::af_t> _activationFunctions;
+    std::vector<Segment> _segments;
+    std::vector<Range> _ranges;
+    size_t _nbOfComputed;
+    Activation::precision_t _precision;
+
+    // Position of every connection of the original network in the CSR arrays.
+    // Connections listed by more than one neuron keep their additional positions in _aliases.
+    std::vector<size_t> _slots;
+    std::vector<std::pair<size_t, size_t> > _aliases;
+
+    // State of the incremental update: the outgoing connections of every neuron as target and CSR position,
+    // the value last broadcast by every neuron, per-neuron flags, and the changed and scheduled neurons.
+    bool _tracking;
+    std::vector<Index_t> _outOffsets;
+    std::vector<Index_t> _outTargets;
+    std::vector<Index_t> _outSlots;
+    std::vector<Scalar_t> _broadcast;
+    std::vector<uint8_t> _flags;
+    std::vector<size_t> _changed;
+    std::vector<size_t> _dirty;
+};
+
+// The default execution plan, with double precision values and size_t indices.
+typedef BasicExecutionPlan<double, size_t> ExecutionPlan;
+
+#endif /* RNN_EXECUTIONPLAN_HPP_ */
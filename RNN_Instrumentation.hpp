@@ -0,0 +1,180 @@
+/*
+ * RNN_Instrumentation.hpp
+ *
+ * Revision: October 2026
+ *
+ * Optional counters and cycle timers for the phases of the network engine.
+ *
+ * Instrumentation is compiled in only when RNN_INSTRUMENTATION is defined before the first include
+ * (for example with -DRNN_INSTRUMENTATION). Otherwise the RNN_COUNT and RNN_PHASE macros expand to
+ * nothing and snapshot() returns zeros.
+ */
+
+#ifndef RNN_INSTRUMENTATION_HPP_
+#define RNN_INSTRUMENTATION_HPP_
+
+// Standard libraries
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Counters and phase timers of the calling thread.
+// Each thread keeps its own numbers, so networks evaluated in parallel do not contend; the writer thread
+// of an AsyncTraceSink counts the bytes it logs in its own numbers.
+class Instrumentation{
+  public:
+    // Events that are counted.
+    enum counter_t{
+      steps,
+      connectionVisits,
+      biasMutations,
+      weightMutations,
+      neuronAdditions,
+      connectionAdditions,
+      bytesLogged,
+      nbCounters
+    };
+
+    // Phases that are timed.
+    enum phase_t{
+      compilation,
+      accumulation,
+      propagation,
+      mutation,
+      logging,
+      nbPhases
+    };
+
+    // True if instrumentation is compiled in.
+#ifdef RNN_INSTRUMENTATION
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // Counter values, and cycles spent in and number of entries into every phase.
+    struct Snapshot{
+      uint64_t counters[nbCounters];
+      uint64_t cycles[nbPhases];
+      uint64_t calls[nbPhases];
+
+      // Returns the numbers accumulated between the supplied earlier snapshot and this one.
+      Snapshot operator-(const Snapshot& earlier) const{
+        Snapshot difference;
+        for(int i = 0; i < nbCounters; i++) difference.counters[i] = counters[i] - earlier.counters[i];
+        for(int i = 0; i < nbPhases; i++){
+          difference.cycles[i] = cycles[i] - earlier.cycles[i];
+          difference.calls[i] = calls[i] - earlier.calls[i];
+        }
+        return difference;
+      }
+    };
+
+    // Returns a copy of the numbers of the calling thread.
+    static Snapshot snapshot(){
+      return current();
+    }
+
+    // Sets all numbers of the calling thread to zero.
+    static void reset(){
+      current() = Snapshot();
+    }
+
+    // Adds the indicated amount to a counter of the calling thread.
+    static void count(counter_t counter, uint64_t amount){
+      current().counters[counter] += amount;
+    }
+
+    // Adds the indicated number of cycles to a phase of the calling thread.
+    static void addCycles(phase_t phase, uint64_t cycles){
+      Snapshot& numbers = current();
+      numbers.cycles[phase] += cycles;
+      numbers.calls[phase]++;
+    }
+
+    // Returns the current value of the cycle counter, or nanoseconds where there is none.
+    static uint64_t cycles(){
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Returns the name of a counter.
+    static const char* getName(counter_t counter){
+      static const char* names[nbCounters] = {"steps", "connection_visits", "bias_mutations", "weight_mutations",
+                                              "neuron_additions", "connection_additions", "bytes_logged"};
+      return names[counter];
+    }
+
+    // Returns the name of a phase.
+    static const char* getName(phase_t phase){
+      static const char* names[nbPhases] = {"compilation", "accumulation", "propagation", "mutation", "logging"};
+      return names[phase];
+    }
+
+    // Writes the supplied numbers as one line per counter and per phase.
+    static void report(std::ostream& output, const Snapshot& numbers){
+      if(!enabled){
+        output << "Instrumentation disabled (define RNN_INSTRUMENTATION)" << std::endl;
+        return;
+      }
+      for(int i = 0; i < nbCounters; i++){
+        output << getName(counter_t(i)) << " " << numbers.counters[i] << std::endl;
+      }
+      for(int i = 0; i < nbPhases; i++){
+        output << getName(phase_t(i)) << " " << numbers.calls[i] << " calls " << numbers.cycles[i] << " cycles" << std::endl;
+      }
+    }
+
+    // Writes the numbers of the calling thread.
+    static void report(std::ostream& output){
+      report(output, snapshot());
+    }
+
+  protected:
+    // Returns the numbers of the calling thread.
+    static Snapshot& current(){
+      thread_local Snapshot numbers = Snapshot();
+      return numbers;
+    }
+};
+
+// Adds the cycles between its construction and destruction to a phase.
+class PhaseTimer{
+  public:
+    // Constructor. Starts timing the indicated phase.
+    explicit PhaseTimer(Instrumentation::phase_t phase):
+      _phase(phase),
+      _start(Instrumentation::cycles()){
+    }
+
+    // Destructor. Stops timing.
+    ~PhaseTimer(){
+      Instrumentation::addCycles(_phase, Instrumentation::cycles() - _start);
+    }
+
+  protected:
+    Instrumentation::phase_t _phase;
+    uint64_t _start;
+};
+
+#define RNN_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define RNN_INSTRUMENTATION_NAME_(line) RNN_INSTRUMENTATION_CONCAT_(rnnPhaseTimer, line)
+
+#ifdef RNN_INSTRUMENTATION
+// Adds the indicated amount to an Instrumentation counter.
+#define RNN_COUNT(counter, amount) Instrumentation::count(Instrumentation::counter, (amount))
+// Times the rest of the enclosing scope as an Instrumentation phase.
+#define RNN_PHASE(phase) PhaseTimer RNN_INSTRUMENTATION_NAME_(__LINE__)(Instrumentation::phase)
+#else
+#define RNN_COUNT(counter, amount) ((void)0)
+#define RNN_PHASE(phase) ((void)0)
+#endif
+
+#endif /* RNN_INSTRUMENTATION_HPP_ */
@@ -0,0 +1,231 @@
+/*
+ * RNN_NetworkFile.hpp
+ *
+ * Revision: October 2026
+ *
+ * A versioned binary file format for neural networks.
+ *
+ * Layout (native byte order, every section aligned to 8 bytes):
+ * - header: magic "RNNB", version, number of inputs, outputs, neurons and connections
+ * - biases: one double per neuron
+ * - lambdas: one double per neuron
+ * - activation functions: one byte per neuron, padded to a multiple of 8 bytes
+ * - connections: one (source, target, weight) triple per connection
+ *
+ * Values are always stored as double and indices as 64-bit integers, so a file can be loaded into a network
+ * of any scalar and index type; float and 16-bit fixed-point networks round-trip exactly.
+ */
+
+#ifndef RNN_NETWORKFILE_HPP_
+#define RNN_NETWORKFILE_HPP_
+
+// Standard libraries
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Local libraries
+#include "Misc_MappedFile.hpp"
+#include "RNN_ExecutionPlan.hpp"
+#include "RNN_NeuralNetwork.hpp"
+
+// Header at the start of a binary network file.
+struct NetworkFileHeader{
+  char magic[4];
+  uint32_t version;
+  uint64_t nbOfInputs;
+  uint64_t nbOfOutputs;
+  uint64_t nbOfNeurons;
+  uint64_t nbOfConnections;
+};
+
+// A connection as stored in a binary network file.
+struct NetworkFileConnection{
+  uint64_t source;
+  uint64_t target;
+  double weight;
+};
+
+// Reads and writes networks in the binary network file format.
+class NetworkFile{
+  public:
+    // Current version of the format.
+    static constexpr uint32_t version = 1;
+
+    // Writes the supplied network to the indicated file. Returns false on failure.
+    template<typename Neuron_t, typename Connection_t>
+    static bool save(const std::string& fileName, NeuralNetwork<Neuron_t, Connection_t>& network){
+      size_t nbOfNeurons = network.getNbOfNeurons();
+      size_t nbOfConnections = network.getNbOfConnections();
+      NetworkFileHeader header;
+      std::memcpy(header.magic, "RNNB", 4);
+      header.version = version;
+      header.nbOfInputs = network.getInputs();
+      header.nbOfOutputs = network.getOutputs();
+      header.nbOfNeurons = nbOfNeurons;
+      header.nbOfConnections = nbOfConnections;
+
+      std::vector<double> biases(nbOfNeurons);
+      std::vector<double> lambdas(nbOfNeurons);
+      std::vector<uint8_t> activationFunctions(padding(nbOfNeurons), 0);
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        biases[i] = double(network.getBias(i));
+        lambdas[i] = double(network.getLambda(i));
+        activationFunctions[i] = uint8_t(network.getActivationFunction(i));
+      }
+      // Dead connections are skipped, so the file always holds a compact connection list.
+      std::vector<NetworkFileConnection> connections;
+      connections.reserve(nbOfConnections);
+      for(size_t i = 0; i < network.getNbOfConnectionSlots(); i++){
+        if(!network.isAlive(i)) continue;
+        NetworkFileConnection connection;
+        connection.source = network.getSource(i);
+        connection.target = network.getTarget(i);
+        connection.weight = double(network.getWeight(i));
+        connections.push_back(connection);
+      }
+
+      std::ofstream file(fileName.c_str(), std::ios::binary);
+      if(!file.is_open()){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+        return false;
+      }
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(biases.data()), biases.size() * sizeof(double));
+      file.write(reinterpret_cast<const char*>(lambdas.data()), lambdas.size() * sizeof(double));
+      file.write(reinterpret_cast<const char*>(activationFunctions.data()), activationFunctions.size());
+      file.write(reinterpret_cast<const char*>(connections.data()), connections.size() * sizeof(NetworkFileConnection));
+      return bool(file);
+    }
+
+    // Replaces the supplied network with the one stored in the indicated file. Returns false on failure.
+    template<typename Neuron_t, typename Connection_t>
+    static bool load(const std::string& fileName, NeuralNetwork<Neuron_t, Connection_t>& network){
+      typedef typename Neuron_t::scalar_t scalar_t;
+      MappedFile file;
+      View view;
+      if(!file.open(fileName) || !parse(file, fileName, view)) return false;
+      const NetworkFileHeader& header = *view.header;
+      network.clear();
+      network.reserve(header.nbOfNeurons, header.nbOfConnections);
+      network.setInputs(header.nbOfInputs);
+      network.setOutputs(header.nbOfOutputs);
+      for(size_t i = 0; i < header.nbOfNeurons; i++){
+        network.addNeuron();
+        network.setBias(i, scalar_t(view.biases[i]));
+        network.setLambda(i, scalar_t(view.lambdas[i]));
+        network.setActivationFunction(i, typename Neuron_t::af_t(view.activationFunctions[i]));
+      }
+      for(size_t i = 0; i < header.nbOfConnections; i++){
+        const NetworkFileConnection& connection = view.connections[i];
+        network.addConnection(connection.source, connection.target, scalar_t(connection.weight));
+      }
+      return true;
+    }
+
+    // Builds an execution plan directly from the indicated file, with all activations at zero.
+    // Returns false on failure.
+    template<typename Scalar_t, typename Index_t>
+    static bool loadPlan(const std::string& fileName, BasicExecutionPlan<Scalar_t, Index_t>& plan){
+      MappedFile file;
+      View view;
+      if(!file.open(fileName) || !parse(file, fileName, view)) return false;
+      size_t nbOfNeurons = view.header->nbOfNeurons;
+      size_t nbOfConnections = view.header->nbOfConnections;
+      // Groups the connections by target, keeping file order within each target.
+      std::vector<size_t> offsets(nbOfNeurons + 1, 0);
+      for(size_t i = 0; i < nbOfConnections; i++){
+        offsets[view.connections[i].target + 1]++;
+      }
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        offsets[i + 1] += offsets[i];
+      }
+      std::vector<size_t> order(nbOfConnections);
+      for(size_t i = 0; i < nbOfConnections; i++){
+        order[offsets[view.connections[i].target]++] = i;
+      }
+      plan.clear(nbOfNeurons, nbOfConnections);
+      size_t next = 0;
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        plan.addNeuron(Scalar_t(0), Scalar_t(0), Scalar_t(view.biases[i]), Scalar_t(view.lambdas[i]), Neuron::af_t(view.activationFunctions[i]));
+        for(; next < nbOfConnections && view.connections[order[next]].target == i; next++){
+          const NetworkFileConnection& connection = view.connections[order[next]];
+          plan.addIncoming(order[next], connection.source, Scalar_t(connection.weight));
+        }
+      }
+      return true;
+    }
+
+  protected:
+    // Pointers into the sections of a mapped file.
+    struct View{
+      const NetworkFileHeader* header;
+      const double* biases;
+      const double* lambdas;
+      const uint8_t* activationFunctions;
+      const NetworkFileConnection* connections;
+    };
+
+    // Rounds the supplied size up to a multiple of 8 bytes.
+    static size_t padding(size_t size){
+      return (size + 7) & ~size_t(7);
+    }
+
+    // Validates a mapped file and locates its sections. Returns false if the file is malformed.
+    static bool parse(const MappedFile& file, const std::string& fileName, View& view){
+      const char* data = file.data();
+      if(file.size() < sizeof(NetworkFileHeader) || std::memcmp(data, "RNNB", 4) != 0){
+        std::cerr << "Not a network file: " << fileName << std::endl;
+        return false;
+      }
+      view.header = reinterpret_cast<const NetworkFileHeader*>(data);
+      if(view.header->version != version){
+        std::cerr << "Unsupported network file version " << view.header->version << ": " << fileName << std::endl;
+        return false;
+      }
+      uint64_t nbOfNeurons = view.header->nbOfNeurons;
+      uint64_t nbOfConnections = view.header->nbOfConnections;
+      // Every neuron takes at least 17 bytes and every connection 24, so bounding the counts by the file size
+      // keeps the expected size below from overflowing.
+      size_t available = file.size() - sizeof(NetworkFileHeader);
+      if(nbOfNeurons > available / (2 * sizeof(double) + 1) || nbOfConnections > available / sizeof(NetworkFileConnection)){
+        std::cerr << "Truncated network file: " << fileName << std::endl;
+        return false;
+      }
+      if(view.header->nbOfInputs > nbOfNeurons || view.header->nbOfOutputs > nbOfNeurons - view.header->nbOfInputs){
+        std::cerr << "Invalid network file: " << nbOfNeurons << " neurons for " << view.header->nbOfInputs << " inputs and " << view.header->nbOfOutputs << " outputs: " << fileName << std::endl;
+        return false;
+      }
+      size_t expected = sizeof(NetworkFileHeader) + 2 * nbOfNeurons * sizeof(double) + padding(nbOfNeurons) + nbOfConnections * sizeof(NetworkFileConnection);
+      if(file.size() != expected){
+        std::cerr << "Truncated network file: " << fileName << std::endl;
+        return false;
+      }
+      data += sizeof(NetworkFileHeader);
+      view.biases = reinterpret_cast<const double*>(data);
+      data += nbOfNeurons * sizeof(double);
+      view.lambdas = reinterpret_cast<const double*>(data);
+      data += nbOfNeurons * sizeof(double);
+      view.activationFunctions = reinterpret_cast<const uint8_t*>(data);
+      data += padding(nbOfNeurons);
+      view.connections = reinterpret_cast<const NetworkFileConnection*>(data);
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        if(view.activationFunctions[i] >= Neuron::nbActivationFunctions){
+          std::cerr << "Invalid activation function in network file: " << fileName << std::endl;
+          return false;
+        }
+      }
+      for(size_t i = 0; i < nbOfConnections; i++){
+        if(view.connections[i].source >= nbOfNeurons || view.connections[i].target >= nbOfNeurons){
+          std::cerr << "Invalid connection in network file: " << fileName << std::endl;
+          return false;
+        }
+      }
+      return true;
+    }
+};
+
+#endif /* RNN_NETWORKFILE_HPP_ */
@@ -0,0 +1,215 @@
+/*
+ * RNN_NetworkHandle.hpp
+ *
+ * Revision: October 2026
+ *
+ * A deployed network that is replaced by a writer thread while reader threads keep stepping it.
+ */
+
+#ifndef RNN_NETWORKHANDLE_HPP_
+#define RNN_NETWORKHANDLE_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Local libraries
+#include "RNN_NeuralNetwork.hpp"
+
+// Hands new versions of a network from a writer, e.g. an evolution thread, to readers stepping it in a control loop.
+// publish() stores a compiled copy of a network as the current version. Each Reader steps its own copy and picks up
+// a newer version with refresh() at a step boundary: one atomic load when nothing changed, and otherwise a copy that
+// shares the storage of the published version (see Misc_CopyOnWrite.hpp). Readers never lock.
+// Old versions are reclaimed by epochs: a reader announces the epoch while it copies the current version, and a
+// version replaced in epoch r is deleted once no reader still announces an epoch before r.
+template<typename Network_t = NeuralNetwork<> >
+class NetworkHandle{
+  protected:
+    // A published network and its number.
+    struct Version{
+      Version(const Network_t& network, uint64_t number):
+        network(network),
+        number(number){
+      }
+
+      Network_t network;
+      uint64_t number;
+    };
+
+    // The epoch announced by one reader, or quiescent.
+    struct Slot{
+      Slot():
+        epoch(quiescent),
+        used(false){
+      }
+
+      std::atomic<uint64_t> epoch;
+      std::atomic<bool> used;
+    };
+
+    // Epoch of a reader that is not copying a version.
+    static constexpr uint64_t quiescent = ~uint64_t(0);
+
+  public:
+    // Steps a private copy of the current version of a handle.
+    // A reader must be used by one thread at a time and destroyed before its handle.
+    class Reader{
+      public:
+        // Constructor. Registers with the handle and copies its current version.
+        explicit Reader(NetworkHandle& handle):
+          _handle(handle),
+          _slot(0),
+          _version(0){
+          for(size_t i = 0; i < _handle._slots.size() && !_slot; i++){
+            bool used = false;
+            if(_handle._slots[i].used.compare_exchange_strong(used, true)) _slot = &_handle._slots[i];
+          }
+          if(!_slot){
+            std::cerr << "No reader slot left! Readers: " << _handle._slots.size() << std::endl;
+            return;
+          }
+          this->refresh();
+        }
+
+        // Destructor. Frees the slot of the reader.
+        ~Reader(){
+          if(_slot) _slot->used.store(false, std::memory_order_release);
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        // Switches to the newest published version, if it is not the one held. Returns true if it switched.
+        // The activation state is carried over neuron by neuron: by index, or through getPermutation() if the new
+        // network was reordered once more than the held one. A network reordered more often starts from its
+        // published state. Call between steps, e.g. before every run().
+        bool refresh(){
+          if(!_slot || _handle._version.load(std::memory_order_acquire) == _version) return false;
+          _slot->epoch.store(_handle._epoch.load());
+          const Version* current = _handle._current.load();
+          Network_t network(current->network);
+          uint64_t version = current->number;
+          _slot->epoch.store(quiescent, std::memory_order_release);
+          if(_version != 0) this->transferState(network);
+          _network = std::move(network);
+          _version = version;
+          return true;
+        }
+
+        // Returns the network of this reader, for stepping it e.g. with run(inputs, outputs, steps).
+        Network_t& getNetwork(){
+          return _network;
+        }
+
+        // Returns the number of the version held, or 0 if the reader has no slot.
+        uint64_t getVersion() const{
+          return _version;
+        }
+
+      protected:
+        // Copies the activation values and incoming potentials of the held network into the supplied one.
+        void transferState(Network_t& network){
+          size_t reorderings = network.getNbOfReorderings();
+          size_t heldReorderings = _network.getNbOfReorderings();
+          if(reorderings != heldReorderings && reorderings != heldReorderings + 1) return;
+          bool permuted = reorderings != heldReorderings;
+          const typename Network_t::plan_t& plan = _network.getExecutionPlan();
+          const std::vector<size_t>& permutation = network.getPermutation();
+          size_t nbOfNeurons = network.getNbOfNeurons();
+          for(size_t i = 0; i < plan.size(); i++){
+            size_t j = i;
+            if(permuted){
+              if(i >= permutation.size()) continue;
+              j = permutation[i];
+            }
+            if(j >= nbOfNeurons) continue;
+            network.setValue(j, plan.getValue(i));
+            network.setIncoming(j, plan.getIncoming(i));
+          }
+        }
+
+        NetworkHandle& _handle;
+        Slot* _slot;
+        Network_t _network;
+        uint64_t _version;
+    };
+
+    // Constructor. Publishes the supplied network as version 1, with room for the indicated number of readers.
+    NetworkHandle(const Network_t& network, size_t maxReaders = 8):
+      _slots(maxReaders),
+      _current(0),
+      _version(0),
+      _epoch(1){
+      this->publish(network);
+    }
+
+    // Destructor. Deletes all versions. The readers must have been destroyed.
+    ~NetworkHandle(){
+      delete _current.load();
+      for(size_t i = 0; i < _retired.size(); i++){
+        delete _retired[i].first;
+      }
+    }
+
+    NetworkHandle(const NetworkHandle&) = delete;
+    NetworkHandle& operator=(const NetworkHandle&) = delete;
+
+    // Publishes a compiled copy of the supplied network as the new current version, and deletes the replaced
+    // versions that no reader can still be copying. Concurrent calls from different threads are serialized.
+    void publish(const Network_t& network){
+      Version* version = new Version(network, 0);
+      version->network.getExecutionPlan();
+      std::lock_guard<std::mutex> lock(_writerMutex);
+      version->number = _version.load(std::memory_order_relaxed) + 1;
+      Version* replaced = _current.exchange(version);
+      _version.store(version->number, std::memory_order_release);
+      if(replaced) _retired.push_back(std::make_pair(replaced, _epoch.fetch_add(1) + 1));
+      this->reclaim();
+    }
+
+    // Returns the number of the current version.
+    uint64_t getVersion() const{
+      return _version.load(std::memory_order_acquire);
+    }
+
+    // Returns the number of replaced versions not deleted yet.
+    size_t getNbOfRetired(){
+      std::lock_guard<std::mutex> lock(_writerMutex);
+      return _retired.size();
+    }
+
+  protected:
+    // Deletes the replaced versions retired in an epoch no later than the oldest epoch announced by a reader.
+    // A reader that announced that epoch or a later one loaded the current version after they were replaced.
+    void reclaim(){
+      uint64_t oldest = quiescent;
+      for(size_t i = 0; i < _slots.size(); i++){
+        oldest = std::min(oldest, _slots[i].epoch.load());
+      }
+      size_t nbOfKept = 0;
+      for(size_t i = 0; i < _retired.size(); i++){
+        if(_retired[i].second <= oldest) delete _retired[i].first;
+        else _retired[nbOfKept++] = _retired[i];
+      }
+      _retired.resize(nbOfKept);
+    }
+
+    // Reader slots.
+    std::vector<Slot> _slots;
+
+    // The current version, its number and the global epoch.
+    std::atomic<Version*> _current;
+    std::atomic<uint64_t> _version;
+    std::atomic<uint64_t> _epoch;
+
+    // Replaced versions with the epoch in which they were replaced (guarded by _writerMutex).
+    std::vector<std::pair<Version*, uint64_t> > _retired;
+    std::mutex _writerMutex;
+};
+
+#endif /* RNN_NETWORKHANDLE_HPP_ */
@@ -10,20 +10,75 @@
 
 // Standard libraries
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 // Local libraries
+#include "Misc_BinaryStream.hpp"
+#include "Misc_CopyOnWrite.hpp"
 #include "Misc_Random.hpp"
+#include "RNN_AdjacencyArena.hpp"
 #include "RNN_Neuron.hpp"
 #include "RNN_Connection.hpp"
+#include "RNN_ConvergenceMonitor.hpp"
+#include "RNN_ExecutionPlan.hpp"
+#include "RNN_Instrumentation.hpp"
+#include "RNN_TraceSink.hpp"
 
 // An artificial neural network class.
+// The scalar type of values, biases and weights is taken from Neuron_t and the index type from Connection_t;
+// both are used by the compiled execution plan, so that e.g. BasicNeuron<float> with BasicConnection<float, uint32_t>
+// runs update() on single precision values and 32-bit indices.
+// Copies of a network share their neurons, connections and adjacency lists in reference-counted chunks, and their
+// execution plan as a whole; each part is copied only when written to, so cloning a network costs little until it
+// is mutated.
 template<typename Neuron_t = Neuron, typename Connection_t = Connection>
 class NeuralNetwork{
   public:
+    typedef typename Neuron_t::scalar_t scalar_t;
+    typedef typename Connection_t::index_t index_t;
+    typedef BasicExecutionPlan<scalar_t, index_t> plan_t;
+    typedef BasicBatchState<scalar_t> batch_t;
+    typedef AdjacencyArena<index_t> adjacency_t;
+    typedef CowVector<Neuron_t> neurons_t;
+    typedef CowVector<Connection_t> connections_t;
+
+    // Function filling the input values of the indicated step; returns false when the stream has no more steps.
+    typedef std::function<bool(size_t, scalar_t*)> source_t;
+
+    // Orders of the hidden neurons produced by reorderNeurons().
+    // - breadthFirst: the order in which a breadth-first search from the inputs, then the outputs, reaches them
+    // - reverseCuthillMcKee: reverse Cuthill-McKee order of the hidden neurons, which keeps the index distance
+    //   between connected neurons (the bandwidth) small
+    enum reordering_t{
+      breadthFirst,
+      reverseCuthillMcKee
+    };
+
     // Builds a recurrent neural network with the supplied number of input and output neurons.
-    NeuralNetwork(size_t nbOfInputs = 4, size_t nbOfOutputs = 8){
+    // The random number engine of the network is seeded from the generator of the calling thread.
+    NeuralNetwork(size_t nbOfInputs = 4, size_t nbOfOutputs = 8):
+      _compactionThreshold(0.5),
+      _reordering(breadthFirst),
+      _reorderingInterval(0),
+      _nbOfNewNeurons(0),
+      _nbOfReorderings(0),
+      _weightMutRate(0.0),
+      _neuronMutRate(0.0),
+      _addNeuronMutRate(0.0),
+      _addConnectionMutRate(0.0),
+      _rng(generator()()),
+      _planDirty(true),
+      _neuronsStale(false),
+      _incrementalUpdate(false),
+      _updateEpsilon(0.0),
+      _outputOnly(false),
+      _liveStale(true){
       this->setInputs(nbOfInputs);
       this->setOutputs(nbOfOutputs);
       size_t numberOfNeurons = _nbOfInputs + _nbOfOutputs;
@@ -41,41 +96,230 @@ class NeuralNetwork{
 
     // Adds a neuron to this network.
     void addNeuron(){
-      _neurons.push_back(Neuron());
+      this->invalidatePlan();
+      _neurons.push_back(Neuron_t());
+      _incomingIndices.addList();
+      _outgoingIndices.addList();
+      // A new hidden neuron has no path to an output; a new output neuron needs a full recomputation.
+      if(_neurons.size() <= _nbOfInputs + _nbOfOutputs) _liveStale = true;
+      else if(_outputOnly && !_liveStale) _liveNeurons.push_back(false);
     }
 
-    // Adds a connection between the two indicated neurons.
-    void addConnection(size_t sourceIndex, size_t targetIndex, double weight = 0.0){
-      _connections.push_back(Connection(sourceIndex, targetIndex, weight));
-      this->addIncoming(targetIndex, _connections.size() - 1);
-      this->addOutgoing(sourceIndex, _connections.size() - 1);
+    // Adds a connection between the two indicated neurons and returns its index.
+    // The storage of a removed connection is reused if there is one.
+    size_t addConnection(size_t sourceIndex, size_t targetIndex, scalar_t weight = scalar_t(0)){
+      this->invalidatePlan();
+      size_t connectionIndex = _connections.size();
+      if(_freeConnections.empty()){
+        _connections.push_back(Connection_t(sourceIndex, targetIndex, weight));
+      }
+      else{
+        connectionIndex = _freeConnections.back();
+        _freeConnections.pop_back();
+        _connections.write(connectionIndex) = Connection_t(sourceIndex, targetIndex, weight);
+      }
+      this->addIncoming(targetIndex, connectionIndex);
+      this->addOutgoing(sourceIndex, connectionIndex);
+      return connectionIndex;
     }
 
     // Removes a connection between the two indicated neurons.
+    // The connection is marked dead and its index is kept for reuse, so the indices of other connections do not change,
+    // unless the fraction of dead connections exceeds the compaction threshold (see compactConnections()).
     void removeConnection(size_t connectionIndex, size_t sourceIndex, size_t targetIndex){
-      _connections.erase(_connections.begin() + connectionIndex);
-      this->updateIndices(_neurons[sourceIndex].getOutgoingIndices(), connectionIndex);
-      this->updateIndices(_neurons[targetIndex].getIncomingIndices(), connectionIndex);
+      this->invalidatePlan();
+      // Only a connection to a live neuron can cut a path to an output.
+      if(_outputOnly && !_liveStale && _liveNeurons[targetIndex]) _liveStale = true;
+      _connections.write(connectionIndex).kill();
+      _freeConnections.push_back(connectionIndex);
+      _outgoingIndices.remove(sourceIndex, connectionIndex);
+      _incomingIndices.remove(targetIndex, connectionIndex);
+      if(_freeConnections.size() > _compactionThreshold * _connections.size()){
+        this->compactConnections();
+      }
     }
 
-    // Updates the vector of connection indices after removing an existing connection.
-    void updateIndices(std::vector<size_t> vect, size_t value){
-      vect.erase(std::remove(vect.begin(), vect.end(), value), vect.end());
-      for(int i = 0; i < vect.size(); i++){
-        if(vect[i] > value){
-          vect[i] = vect[i]-1;
+    // Removes the indicated connection.
+    void removeConnection(size_t connectionIndex){
+      this->removeConnection(connectionIndex, this->getSource(connectionIndex), this->getTarget(connectionIndex));
+    }
+
+    // Removes the storage of dead connections, renumbering the live ones in their current order,
+    // and rewrites the connection indices of all neurons in one sweep.
+    // Returns the new index of every old connection index (npos for dead connections).
+    std::vector<size_t> compactConnections(){
+      this->invalidatePlan();
+      std::vector<size_t> remap(_connections.size(), plan_t::npos);
+      size_t nbOfAlive = 0;
+      for(size_t i = 0; i < _connections.size(); i++){
+        if(!_connections[i].isAlive()) continue;
+        remap[i] = nbOfAlive;
+        if(nbOfAlive != i){
+          Connection_t connection = _connections[i];
+          _connections.write(nbOfAlive) = connection;
+        }
+        nbOfAlive++;
+      }
+      _connections.truncate(nbOfAlive);
+      _freeConnections.clear();
+      _incomingIndices.remap(remap);
+      _outgoingIndices.remap(remap);
+      return remap;
+    }
+
+    // Renumbers the hidden neurons so that connected neurons get nearby indices, which makes the gathers of update()
+    // touch fewer cache lines once mutations have appended neurons all over the network.
+    // Input and output neurons keep their indices. Neurons move with their state, connections keep their indices
+    // and weights and incoming lists keep their order, so update() computes the same outputs as before.
+    // Returns the new index of every old neuron index, which stays available through getPermutation().
+    const std::vector<size_t>& reorderNeurons(reordering_t reordering = breadthFirst){
+      this->invalidatePlan();
+      this->syncLists();
+      size_t nbOfNeurons = _neurons.size();
+      size_t nbOfFixed = std::min(_nbOfInputs + _nbOfOutputs, nbOfNeurons);
+      std::vector<size_t> order;
+      order.reserve(nbOfNeurons - nbOfFixed);
+      std::vector<char> visited(nbOfNeurons, 0);
+      std::fill(visited.begin(), visited.begin() + nbOfFixed, 1);
+      std::vector<size_t> degree;
+      if(reordering == reverseCuthillMcKee){
+        degree.resize(nbOfNeurons);
+        for(size_t i = 0; i < nbOfNeurons; i++){
+          degree[i] = _incomingIndices.get(i).size() + _outgoingIndices.get(i).size();
+        }
+      }
+      std::vector<size_t> seeds;
+      if(reordering == breadthFirst){
+        // The search starts from the inputs and outputs together, hidden neurons they do not reach come after.
+        for(size_t i = 0; i < nbOfFixed; i++){
+          this->appendNeighbours(i, order, visited, degree);
+        }
+        for(size_t i = nbOfFixed; i < nbOfNeurons; i++){
+          seeds.push_back(i);
+        }
+      }
+      else{
+        // Every connected part of the hidden neurons is searched from a neuron of lowest degree.
+        for(size_t i = nbOfFixed; i < nbOfNeurons; i++){
+          seeds.push_back(i);
         }
+        std::stable_sort(seeds.begin(), seeds.end(), [&degree](size_t a, size_t b){ return degree[a] < degree[b]; });
+      }
+      size_t next = 0;
+      for(size_t k = 0; k <= seeds.size(); k++){
+        while(next < order.size()){
+          this->appendNeighbours(order[next++], order, visited, degree);
+        }
+        if(k == seeds.size()) break;
+        if(visited[seeds[k]]) continue;
+        visited[seeds[k]] = 1;
+        order.push_back(seeds[k]);
+      }
+      if(reordering == reverseCuthillMcKee) std::reverse(order.begin(), order.end());
+      _permutation.resize(nbOfNeurons);
+      for(size_t i = 0; i < nbOfFixed; i++){
+        _permutation[i] = i;
       }
+      for(size_t i = 0; i < order.size(); i++){
+        _permutation[order[i]] = nbOfFixed + i;
+      }
+      // Moves neurons, connection endpoints and adjacency lists to their new indices.
+      neurons_t neurons;
+      neurons.reserve(nbOfNeurons);
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        neurons.push_back(_neurons[i < nbOfFixed ? i : order[i - nbOfFixed]]);
+      }
+      _neurons.swap(neurons);
+      for(size_t i = 0; i < _connections.size(); i++){
+        if(!_connections[i].isAlive()) continue;
+        Connection_t connection = _connections[i];
+        _connections.write(i) = Connection_t(_permutation[connection.getSource()], _permutation[connection.getTarget()], connection.getWeight());
+      }
+      _incomingIndices.permute(_permutation);
+      _outgoingIndices.permute(_permutation);
+      _nbOfNewNeurons = 0;
+      _nbOfReorderings++;
+      _liveStale = true;
+      return _permutation;
+    }
+
+    // Returns the permutation applied by the last reordering: the new index of every old neuron index.
+    const std::vector<size_t>& getPermutation() const{
+      return _permutation;
+    }
+
+    // Returns the number of reorderings done so far, for example to notice automatic ones.
+    size_t getNbOfReorderings() const{
+      return _nbOfReorderings;
+    }
+
+    // Makes mutate() reorder the hidden neurons each time it has added the indicated number of neurons since the
+    // last reordering (0 disables automatic reordering, the default). Neuron indices held by the caller must then be
+    // translated with getPermutation() whenever getNbOfReorderings() changes.
+    void setAutomaticReordering(size_t nbOfNewNeurons, reordering_t reordering = breadthFirst){
+      _reorderingInterval = nbOfNewNeurons;
+      _reordering = reordering;
+    }
+
+    // Sets the fraction of dead connection slots above which removeConnection() compacts the connections.
+    // A value of 1 or more disables automatic compaction.
+    void setCompactionThreshold(double compactionThreshold){
+      _compactionThreshold = compactionThreshold;
+    }
+
+    // Returns true if the indicated connection index holds a live connection.
+    bool isAlive(size_t connectionIndex){
+      return connectionIndex < _connections.size() && _connections[connectionIndex].isAlive();
+    }
+
+    // Removes all neurons and connections. Weight constraints and mutation rates are kept.
+    void clear(){
+      _neurons.clear();
+      _connections.clear();
+      _freeConnections.clear();
+      _incomingIndices.clear();
+      _outgoingIndices.clear();
+      this->emptyPlan().clear();
+      _liveStale = true;
+      _planDirty = true;
+      _neuronsStale = false;
+    }
+
+    // Reserves storage for the indicated number of neurons and connections.
+    void reserve(size_t nbOfNeurons, size_t nbOfConnections){
+      _neurons.reserve(nbOfNeurons);
+      _connections.reserve(nbOfConnections);
+      _incomingIndices.reserve(nbOfNeurons, nbOfConnections);
+      _outgoingIndices.reserve(nbOfNeurons, nbOfConnections);
+    }
+
+    // Returns the number of neurons of this network.
+    size_t getNbOfNeurons(){
+      return _neurons.size();
+    }
+
+    // Returns the number of live connections of this network.
+    size_t getNbOfConnections(){
+      return _connections.size() - _freeConnections.size();
+    }
+
+    // Returns the number of connection slots, live or dead. Valid connection indices are below this number.
+    size_t getNbOfConnectionSlots(){
+      return _connections.size();
     }
 
     // Sets the number of inputs of this network.
     void setInputs(size_t nbOfInputs){
+      if(_outputOnly) this->invalidatePlan();
       _nbOfInputs = nbOfInputs;
+      _liveStale = true;
     }
 
     // Sets the number of outputs of this network.
     void setOutputs(size_t nbOfOutputs){
+      if(_outputOnly) this->invalidatePlan();
       _nbOfOutputs = nbOfOutputs;
+      _liveStale = true;
     }
 
     // Returns the number of inputs of this network.
@@ -98,6 +342,16 @@ class NeuralNetwork{
       _maxWeight = maxWeight;
     }
 
+    // Returns the random number engine used to randomize and mutate this network.
+    RandomEngine& getRandomEngine(){
+      return _rng;
+    }
+
+    // Replaces the random number engine used to randomize and mutate this network.
+    void setRandomEngine(const RandomEngine& rng){
+      _rng = rng;
+    }
+
     // Sets the weight mutation rate.
     void setWeightMutRate(double weightMutRate){
       _weightMutRate = weightMutRate;
@@ -114,88 +368,162 @@ class NeuralNetwork{
     }
 
     // Sets the add connection mutation rate.
+    // In output-only mode, pruning is suspended while the rate is not zero (see setOutputOnly()).
     void setAddConnectionMutRate(double addConnectionMutRate){
+      if(_outputOnly && (addConnectionMutRate == 0.0) != (_addConnectionMutRate == 0.0)) this->invalidatePlan();
       _addConnectionMutRate = addConnectionMutRate;
     }
 
-    // Returns a reference to the vector of neurons of this network.
-    std::vector<Neuron_t>& getNeurons(){
+    // Returns a reference to the neurons of this network, stored in chunks shared with copies of the network.
+    // Elements are read through [] and modified through write(), which copies a shared chunk first; the execution
+    // plan is rebuilt on the next update.
+    neurons_t& getNeurons(){
+      this->invalidatePlan();
+      _liveStale = true;
+      return _neurons;
+    }
+
+    // Returns a reference to the connections of this network, stored in chunks shared with copies of the network.
+    // Removed connections are marked dead. Elements are read through [] and modified through write(), which copies a
+    // shared chunk first; the execution plan is rebuilt on the next update.
+    connections_t& getConnections(){
+      this->invalidatePlan();
+      _liveStale = true;
+      return _connections;
+    }
+
+    // Returns the neurons of this network for reading, leaving the execution plan valid.
+    // While the plan is valid it holds the current activation values and incoming potentials (see getValue()).
+    const neurons_t& getNeurons() const{
       return _neurons;
     }
 
-    // Returns a reference to the vector of connections of this network.
-    std::vector<Connection_t>& getConnections(){
+    // Returns the connections of this network for reading, leaving the execution plan valid.
+    const connections_t& getConnections() const{
       return _connections;
     }
 
     // Sets the activation value of the indicated neuron.
-    void setValue(size_t neuronIndex, double value){
-      _neurons[neuronIndex].setValue(value);
+    void setValue(size_t neuronIndex, scalar_t value){
+      _neurons.write(neuronIndex).setValue(value);
+      if(!_planDirty) _plan.write().setValue(neuronIndex, value);
     }
 
     // Returns the activation value of the indicated neuron.
-    double getValue(size_t neuronIndex){
+    scalar_t getValue(size_t neuronIndex){
       if(neuronIndex >= _neurons.size()){
         std::cerr << "Index out of bounds! Index: " << neuronIndex << " size: " << _neurons.size() << std::endl;
       }
+      if(!_planDirty) return _plan->getValue(neuronIndex);
       return _neurons[neuronIndex].getValue();
     }
 
     // Sets the bias of the indicated neuron.
-    void setBias(size_t neuronIndex, double bias){
-      _neurons[neuronIndex].setBias(bias);
+    void setBias(size_t neuronIndex, scalar_t bias){
+      _neurons.write(neuronIndex).setBias(bias);
+      if(!_planDirty) _plan.write().setBias(neuronIndex, bias);
     }
 
     // Returns the bias of the indicated neuron.
-    double getBias(size_t neuronIndex){
+    scalar_t getBias(size_t neuronIndex){
       if(neuronIndex >= _neurons.size()){
         std::cerr << "Index out of bounds! Index: " << neuronIndex << " size: " << _neurons.size() << std::endl;
       }
       return _neurons[neuronIndex].getBias();
     }
 
+    // Sets the activation function of the indicated neuron.
+    void setActivationFunction(size_t neuronIndex, typename Neuron_t::af_t activation){
+      this->invalidatePlan();
+      _neurons.write(neuronIndex).setActivationFunction(activation);
+    }
+
+    // Returns the activation function of the indicated neuron.
+    typename Neuron_t::af_t getActivationFunction(size_t neuronIndex){
+      return _neurons[neuronIndex].getActivationFunction();
+    }
+
+    // Sets the sigmoid steepness of the indicated neuron.
+    void setLambda(size_t neuronIndex, scalar_t lambda){
+      this->invalidatePlan();
+      _neurons.write(neuronIndex).setLambda(lambda);
+    }
+
+    // Returns the sigmoid steepness of the indicated neuron.
+    scalar_t getLambda(size_t neuronIndex){
+      return _neurons[neuronIndex].getLambda();
+    }
+
     // Returns the activation value of the indicated output neuron.
-    double getOutputValue(size_t neuronIndex){
+    scalar_t getOutputValue(size_t neuronIndex){
       return this->getValue(neuronIndex + _nbOfInputs);
     }
 
     // Sets the amount of incoming potential of the indicated neuron.
-    void setIncoming(size_t neuronIndex, double incoming){
-      _neurons[neuronIndex].setIncoming(incoming);
+    void setIncoming(size_t neuronIndex, scalar_t incoming){
+      _neurons.write(neuronIndex).setIncoming(incoming);
+      if(!_planDirty) _plan.write().setIncoming(neuronIndex, incoming);
     }
 
     // Updates the current incoming potential of the indicated neuron.
-    void updateIncoming(size_t neuronIndex, double update){
-      _neurons[neuronIndex].updateIncoming(update);
+    void updateIncoming(size_t neuronIndex, scalar_t update){
+      this->syncNeurons();
+      _neurons.write(neuronIndex).updateIncoming(update);
+      if(!_planDirty) _plan.write().setIncoming(neuronIndex, _neurons[neuronIndex].getIncoming());
     }
 
     // Updates the activation value of the indicated neuron.
     void propagateNeuron(size_t neuronIndex){
-      _neurons[neuronIndex].propagate();
+      this->syncNeurons();
+      _neurons.write(neuronIndex).propagate();
+      if(!_planDirty) _plan.write().setValue(neuronIndex, _neurons[neuronIndex].getValue());
     }
 
     // Resets the state of the indicated neuron.
     void resetNeuron(size_t neuronIndex){
-      _neurons[neuronIndex].reset();
+      _neurons.write(neuronIndex).reset();
+      if(!_planDirty){
+        _plan.write().setValue(neuronIndex, 0);
+        _plan.write().setIncoming(neuronIndex, 0);
+      }
     }
 
     // Adds the index of an incoming connection to the indicated neuron.
     void addIncoming(size_t neuronIndex, size_t incomingIndex){
-      _neurons[neuronIndex].addIncoming(incomingIndex);
+      this->invalidatePlan();
+      this->syncLists();
+      _incomingIndices.append(neuronIndex, incomingIndex);
+      // A connection into a live neuron makes its source and everything reaching the source live.
+      if(_outputOnly && !_liveStale && _liveNeurons[neuronIndex]) this->markLive(_connections[incomingIndex].getSource());
     }
 
     // Adds the index of an outgoing connection to the indicated neuron.
     void addOutgoing(size_t neuronIndex, size_t outgoingIndex){
-      _neurons[neuronIndex].addOutgoing(outgoingIndex);
+      this->invalidatePlan();
+      this->syncLists();
+      _outgoingIndices.append(neuronIndex, outgoingIndex);
+    }
+
+    // Returns the indices of the incoming connections of the indicated neuron, valid until the topology changes.
+    typename adjacency_t::List getIncomingIndices(size_t neuronIndex){
+      this->syncLists();
+      return _incomingIndices.get(neuronIndex);
+    }
+
+    // Returns the indices of the outgoing connections of the indicated neuron, valid until the topology changes.
+    typename adjacency_t::List getOutgoingIndices(size_t neuronIndex){
+      this->syncLists();
+      return _outgoingIndices.get(neuronIndex);
     }
 
     // Sets the weight of the indicated connection.
-    void setWeight(size_t connectionIndex, double weight){
-        _connections[connectionIndex].setWeight(weight);
+    void setWeight(size_t connectionIndex, scalar_t weight){
+        _connections.write(connectionIndex).setWeight(weight);
+        if(!_planDirty) _plan.write().setWeight(connectionIndex, weight);
     }
 
     // Returns the weight of the indicated connection.
-    double getWeight(size_t connectionIndex){
+    scalar_t getWeight(size_t connectionIndex){
       if(connectionIndex >= _connections.size()){
         std::cerr << "Index out of bounds! Index: " << connectionIndex << " size: " << _connections.size() << std::endl;
       }
@@ -218,97 +546,237 @@ class NeuralNetwork{
       return _connections[connectionIndex].getTarget();
     }
 
-    // Performs one update of network activation.
-    void update(){
-      // Resets the incoming values of neurons to 0.
-      for(int i = 0; i < _neurons.size(); i++){
-        this->setIncoming(i, 0.0);
+    // Freezes the current topology, parameters and state into the execution plan.
+    // This happens automatically on the first update after a structural change.
+    void compile(){
+      RNN_PHASE(compilation);
+      this->syncNeurons();
+      this->syncLists();
+      plan_t& plan = this->emptyPlan();
+      plan.clear(_neurons.size(), _connections.size());
+      bool pruning = this->isPruning();
+      if(pruning) this->updateLiveNeurons();
+      for(size_t i = 0; i < _neurons.size(); i++){
+        const Neuron_t& neuron = _neurons[i];
+        bool live = !pruning || _liveNeurons[i];
+        plan.addNeuron(neuron.getValue(), neuron.getIncoming(), neuron.getBias(), neuron.getLambda(), neuron.getActivationFunction(), live);
+        if(!live) continue;
+        typename adjacency_t::List incomingConnections = _incomingIndices.get(i);
+        for(size_t j = 0; j < incomingConnections.size(); j++){
+          size_t connectionIndex = incomingConnections[j];
+          plan.addIncoming(connectionIndex, _connections[connectionIndex].getSource(), _connections[connectionIndex].getWeight());
+        }
       }
-      // Updates the incoming values of all neurons by iterating over all their incoming connections.
-      for(int i = 0; i < _neurons.size(); i++){
-        std::vector<size_t> incomingConnections = _neurons[i].getIncomingIndices();
-        for(int j = 0; j < incomingConnections.size(); j++){
-          double updateValue = this->getValue(this->getSource(incomingConnections[j])) * this->getWeight(incomingConnections[j]);
-          this->updateIncoming(i, updateValue);
+      _planDirty = false;
+      _neuronsStale = false;
+    }
+
+    // Returns the execution plan of this network, compiling it if necessary.
+    const plan_t& getExecutionPlan(){
+      if(_planDirty) this->compile();
+      return *_plan;
+    }
+
+    // Selects how update() computes the next activations.
+    // In incremental mode only neurons whose inputs changed are recomputed (see ExecutionPlan::updateIncremental()).
+    // With epsilon = 0 the result is identical to the full update; with epsilon > 0 changes up to epsilon are not propagated.
+    void setIncrementalUpdate(bool incremental, double epsilon = 0.0){
+      _incrementalUpdate = incremental;
+      _updateEpsilon = epsilon;
+    }
+
+    // Selects whether update() computes only the neurons with a path to an output neuron.
+    // The other neurons cannot affect the outputs, so they and their incoming connections are left out of the
+    // execution plan and keep their values and incoming potentials; getOutputValue() returns the same values as with
+    // a full update. Only a new connection from a pruned neuron to a live one can make a pruned neuron matter again,
+    // and it would resume from its frozen state, so pruning is suspended while the add connection mutation rate is
+    // not zero. A connection added by hand from a pruned neuron to a live one still resumes it from its old state.
+    // The live neurons are extended as connections are added, and recomputed after a connection to a live neuron is
+    // removed, except when mutate() splits it with a new neuron, which keeps every path.
+    void setOutputOnly(bool outputOnly){
+      if(outputOnly == _outputOnly) return;
+      this->invalidatePlan();
+      _outputOnly = outputOnly;
+      _liveStale = true;
+    }
+
+    // Returns true if update() computes only the neurons with a path to an output neuron.
+    bool getOutputOnly(){
+      return _outputOnly;
+    }
+
+    // Returns the number of neurons computed by update(): those with a path to an output while pruning.
+    size_t getNbOfLiveNeurons(){
+      if(!this->isPruning()) return _neurons.size();
+      this->updateLiveNeurons();
+      return std::count(_liveNeurons.begin(), _liveNeurons.end(), true);
+    }
+
+    // Selects the precision at which update() evaluates the activation functions (see Activation::precision_t).
+    // Approximations apply to float and double networks; propagateNeuron() always evaluates exactly.
+    void setActivationPrecision(Activation::precision_t precision){
+      _plan.write().setPrecision(precision);
+    }
+
+    // Returns the precision at which update() evaluates the activation functions.
+    Activation::precision_t getActivationPrecision(){
+      return _plan->getPrecision();
+    }
+
+    // Writes the error of every precision of every activation function used by this network.
+    // Each function is measured over the range its neurons can reach: every value lies in [-1, 1], assuming
+    // the same of input values, so a neuron receives at most its bias plus the sum of its absolute weights.
+    void reportActivationErrors(std::ostream& output){
+      const plan_t& plan = this->getExecutionPlan();
+      double bounds[4] = {0.0, 0.0, 0.0, 0.0};
+      bool used[4] = {false, false, false, false};
+      for(size_t i = 0; i < plan.size(); i++){
+        double bound = std::fabs(double(plan.getBiases()[i]));
+        for(size_t j = plan.getOffsets()[i]; j < plan.getOffsets()[i + 1]; j++){
+          bound += std::fabs(double(plan.getWeights()[j]));
         }
+        typename Neuron_t::af_t activation = plan.getActivationFunctions()[i];
+        if(activation < 0 || activation >= 4) continue;
+        if(activation == Neuron_t::sigmoid) bound *= std::fabs(double(plan.getLambdas()[i]));
+        bounds[activation] = std::max(bounds[activation], bound);
+        used[activation] = true;
       }
-      // Propagates the incoming value to become the current activation of that neuron.
-      for(int i = 0; i < _neurons.size(); i++){
-        this->propagateNeuron(i);
+      for(int activation = 0; activation < 4; activation++){
+        if(used[activation]) Activation::report<scalar_t>(output, typename Neuron_t::af_t(activation), -bounds[activation], bounds[activation]);
+      }
+    }
+
+    // Sets the number of threads used by update() (one per hardware thread if 0).
+    // The threads are kept for the lifetime of the network and shared with its copies. Only the full update
+    // runs in parallel, and only on networks large enough to pay off (see ExecutionPlan::minWorkPerThread);
+    // the results are identical to a single-threaded update.
+    void setThreads(size_t nbOfThreads){
+      if(nbOfThreads == 1) _team.reset();
+      else _team = std::make_shared<WorkerTeam>(nbOfThreads);
+      if(_team && _team->size() == 1) _team.reset();
+    }
+
+    // Returns the number of threads used by update().
+    size_t getThreads(){
+      return _team ? _team->size() : 1;
+    }
+
+    // Performs one update of network activation.
+    void update(){
+      if(_planDirty) this->compile();
+      if(_incrementalUpdate) _plan.write().updateIncremental(_updateEpsilon);
+      else if(_team) _plan.write().update(*_team);
+      else _plan.write().update();
+      _neuronsStale = true;
+    }
+
+    // Returns a batch state holding the indicated number of copies of the current activation values.
+    batch_t createBatchState(size_t batchSize){
+      batch_t state(_neurons.size(), batchSize);
+      for(size_t i = 0; i < _neurons.size(); i++){
+        state.setValue(i, this->getValue(i));
       }
+      return state;
+    }
+
+    // Performs one update of every sequence of the supplied batch state.
+    // The topology and weights of this network are shared by all sequences; its own state is unchanged.
+    void update(batch_t& state){
+      if(_planDirty) this->compile();
+      _plan->update(state);
+    }
+
+    // Returns the activation value of the indicated output neuron in the indicated sequence.
+    scalar_t getOutputValue(const batch_t& state, size_t neuronIndex, size_t sequence){
+      return state.getValue(neuronIndex + _nbOfInputs, sequence);
     }
 
     // Randomizes the network.
     void randomize(){
       // Assigns each neuron, uniform randomly, a bias in [_minWeight, _maxWeight]
       for(int i = 0; i < _neurons.size(); i++){
-        this->setBias(i, randDouble(_minWeight, _maxWeight));
+        this->setBias(i, _rng.randDouble(_minWeight, _maxWeight));
       }
       // Assigns each connection, uniform randomly, a weight in [_minWeight, _maxWeight]
-      for(int i = 0; i < _connections.size(); i++){
-        this->setWeight(i, randDouble(_minWeight, _maxWeight));
+      for(size_t i = 0; i < _connections.size(); i++){
+        if(!_connections[i].isAlive()) continue;
+        this->setWeight(i, _rng.randDouble(_minWeight, _maxWeight));
       }
     }
 
-    // Mutates the neural network.
-    void mutate(){
+    // Mutates the neural network. Returns true if anything changed.
+    bool mutate(){
+      RNN_PHASE(mutation);
+      bool changed = false;
       // Probability of neuron-i bias to be mutated.
-      for(int i = 0; i < _neurons.size(); i++){
-        if(randDouble() <= _neuronMutRate){
-          double randBias = randGaussian();
-          if(randBias < _minWeight) this->setBias(i, _minWeight);
-          else if(randBias > _maxWeight) this->setBias(i, _maxWeight);
-          else this->setBias(i, randBias);
-        }
+      // Only the mutated neurons are visited, by skipping geometrically distributed gaps (see nextMutation()).
+      for(size_t i = this->nextMutation(0, _neurons.size(), _neuronMutRate); i < _neurons.size(); i = this->nextMutation(i + 1, _neurons.size(), _neuronMutRate)){
+        RNN_COUNT(biasMutations, 1);
+        changed = true;
+        double randBias = _rng.randGaussian();
+        if(randBias < _minWeight) this->setBias(i, _minWeight);
+        else if(randBias > _maxWeight) this->setBias(i, _maxWeight);
+        else this->setBias(i, randBias);
       }
       // Probability of connection-i weight to be mutated.
-      for(int i = 0; i < _connections.size(); i++){
-        if(randDouble() <= _weightMutRate){
-          double randWeight = randGaussian();
-          if(randWeight < _minWeight) this->setWeight(i, _minWeight);
-          else if(randWeight > _maxWeight) this->setWeight(i, _maxWeight);
-          else this->setWeight(i, randWeight);
-        }
+      // Dead slots are sampled like live ones and skipped, which leaves every live connection an independent trial.
+      for(size_t i = this->nextMutation(0, _connections.size(), _weightMutRate); i < _connections.size(); i = this->nextMutation(i + 1, _connections.size(), _weightMutRate)){
+        if(!_connections[i].isAlive()) continue;
+        RNN_COUNT(weightMutations, 1);
+        changed = true;
+        double randWeight = _rng.randGaussian();
+        if(randWeight < _minWeight) this->setWeight(i, _minWeight);
+        else if(randWeight > _maxWeight) this->setWeight(i, _maxWeight);
+        else this->setWeight(i, randWeight);
       }
       // Probability of adding a new neuron.
-      if(randDouble() <= _addNeuronMutRate){
+      if(this->trial(_addNeuronMutRate) && this->getNbOfConnections() > 0){
+        RNN_COUNT(neuronAdditions, 1);
+        changed = true;
         // Adds a new neuron.
         this->addNeuron();
         // Randomly selects an existing connection.
-        size_t randConnection = randDouble(_connections.size() - 1);
+        size_t randConnection = _rng.randDouble(_connections.size() - 1);
+        while(!_connections[randConnection].isAlive()){
+          randConnection = _rng.randIndex(_connections.size());
+        }
         size_t randSource = this->getSource(randConnection);
         size_t randTarget = this->getTarget(randConnection);
-        double randWeight = this->getWeight(randConnection);
+        scalar_t randWeight = this->getWeight(randConnection);
         // Removes random connection and update indices.
+        // The new neuron restores every path through it, so the live neurons stay exact without a new search.
+        bool liveStale = _liveStale;
         this->removeConnection(randConnection, randSource, randTarget);
+        _liveStale = liveStale;
         // Adds connections of the new neuron.
         addConnection(randSource, _neurons.size()-1, 1.0);
         addConnection(_neurons.size()-1, randTarget, randWeight);
+        _nbOfNewNeurons++;
       }
       // Probability of adding a new connection.
-      if(randDouble() <= _addConnectionMutRate){
-        size_t nodeIndex = 0;
-        size_t newSource = randIndex(_neurons.size());
-        std::vector<size_t> nodeSet;
-        nodeSet.clear();
-        // Remove input neurons from node set.
-        for(int i = _nbOfInputs; i < _neurons.size(); i++){
-          nodeSet.push_back(i);
-        }
-        // Adds new connection to available node.
-        if(!nodeSet.empty()){
-          size_t newTarget = nodeSet[randIndex(nodeSet.size())];
-          this->addConnection(newSource, newTarget, randDouble(_minWeight, _maxWeight));
+      if(this->trial(_addConnectionMutRate)){
+        size_t newSource = _rng.randIndex(_neurons.size());
+        // Adds new connection to a random non-input neuron, if any.
+        if(_nbOfInputs < _neurons.size()){
+          RNN_COUNT(connectionAdditions, 1);
+          changed = true;
+          size_t newTarget = _rng.randIndex(_nbOfInputs, _neurons.size());
+          this->addConnection(newSource, newTarget, _rng.randDouble(_minWeight, _maxWeight));
         }
       }
+      if(_reorderingInterval > 0 && _nbOfNewNeurons >= _reorderingInterval){
+        this->reorderNeurons(_reordering);
+      }
+      return changed;
     }
 
     // Initializes the network with specific values and weights.
-    void initialize(double initValue, double initWeight){
+    void initialize(scalar_t initValue, scalar_t initWeight){
       for(int i = 0; i < _neurons.size(); i++){
         this->setValue(i, initValue);
       }
-      for(int i = 0; i < _connections.size(); i++){
+      for(size_t i = 0; i < _connections.size(); i++){
+        if(!_connections[i].isAlive()) continue;
         this->setWeight(i, initWeight);
       }
     }
@@ -322,31 +790,440 @@ class NeuralNetwork{
 
     // Writes the current activation of the network to the output stream.
     void logActivation(std::ofstream& activationFile){
+      RNN_PHASE(logging);
       if(activationFile.is_open()){
-        activationFile << this->getValue(0);
-        for(int i = 1; i < _neurons.size(); i++){
-          activationFile << " " << this->getValue(i);
+        char buffer[16];
+        for(size_t i = 0; i < _neurons.size(); i++){
+          char* last = std::to_chars(buffer, buffer + sizeof(buffer), double(this->getValue(i)), std::chars_format::general, 6).ptr;
+          if(i > 0) activationFile.put(' ');
+          activationFile.write(buffer, last - buffer);
+          RNN_COUNT(bytesLogged, last - buffer + 1);
         }
-        activationFile << "\n";
+        activationFile.put('\n');
+      }
+    }
+
+    // Writes the current activation of the network to the trace sink.
+    void logActivation(TraceSink& sink){
+      RNN_PHASE(logging);
+      if(_planDirty) this->compile();
+      if constexpr(std::is_same<scalar_t, double>::value){
+        sink.write(_plan->getValues().data(), _plan->size());
+      }
+      else{
+        _traceRow.resize(_plan->size());
+        for(size_t i = 0; i < _plan->size(); i++){
+          _traceRow[i] = double(_plan->getValue(i));
+        }
+        sink.write(_traceRow.data(), _traceRow.size());
       }
     }
 
     // Run the neural network for a given number of updates.
+    // The activations are written as text to the indicated file, if any.
     void run(size_t numberOfUpdates, std::string activationFileName = ""){
-      std::ofstream actFile;
-      if(activationFileName != "") actFile.open(activationFileName);
-      for(int i = 0; i < numberOfUpdates; i++){
-        this->update();
-        this->logActivation(actFile);
-        this->mutate();
+      if(activationFileName == ""){
+        this->runSteps(numberOfUpdates, 0, 0);
+        return;
+      }
+      TextTraceSink sink(activationFileName);
+      this->runSteps(numberOfUpdates, &sink, 0);
+    }
+
+    // Run the neural network for a given number of updates, writing the activations to the trace sink.
+    void run(size_t numberOfUpdates, TraceSink& sink){
+      this->runSteps(numberOfUpdates, &sink, 0);
+      sink.flush();
+    }
+
+    // Run the neural network for at most a given number of updates, until the monitor detects a fixed point
+    // or a limit cycle. The monitor is reset first and reports the outcome afterwards.
+    // Detection only spans steps in which mutate() left the network unchanged, so it is meant for networks
+    // evaluated with all mutation rates at zero. On detection the run stops, or with ConvergenceMonitor::fastForward
+    // the activations jump to the values the remaining updates would reach; the skipped updates are not logged.
+    // With all mutation rates at zero, the skipped calls of mutate() are still made, which costs no update but leaves
+    // the random engine where the full run would; otherwise they are not made and the random stream diverges.
+    // Returns the number of updates performed.
+    size_t run(size_t numberOfUpdates, ConvergenceMonitor& monitor){
+      return this->runSteps(numberOfUpdates, 0, &monitor);
+    }
+
+    // Same as above, writing the activations of the performed updates to the trace sink.
+    size_t run(size_t numberOfUpdates, ConvergenceMonitor& monitor, TraceSink& sink){
+      size_t nbOfUpdates = this->runSteps(numberOfUpdates, &sink, &monitor);
+      sink.flush();
+      return nbOfUpdates;
+    }
+
+    // Run the neural network for a given number of updates driven by external inputs.
+    // inputs holds one row of getInputs() values per update, which are set on the input neurons before it;
+    // the values of the output neurons after the update are written to the same row of outputs, which holds
+    // getOutputs() values per update. Unlike the other overloads the network is not mutated, and apart from
+    // compiling a changed network nothing is allocated and no index is checked.
+    void run(const scalar_t* inputs, scalar_t* outputs, size_t numberOfUpdates){
+      if(_planDirty) this->compile();
+      plan_t& plan = _plan.write();
+      for(size_t i = 0; i < numberOfUpdates; i++){
+        this->streamStep(plan, inputs + i * _nbOfInputs, outputs + i * _nbOfOutputs);
+      }
+    }
+
+    // Same as above, pulling the inputs of every update from a source, e.g. a sensor stream, into a buffer of
+    // getInputs() values. Runs until the source returns false or the given number of updates is reached.
+    // Returns the number of updates performed.
+    size_t run(const source_t& source, scalar_t* outputs, size_t numberOfUpdates){
+      if(_planDirty) this->compile();
+      plan_t& plan = _plan.write();
+      _inputRow.resize(_nbOfInputs);
+      for(size_t i = 0; i < numberOfUpdates; i++){
+        if(!source(i, _inputRow.data())) return i;
+        this->streamStep(plan, _inputRow.data(), outputs + i * _nbOfOutputs);
+      }
+      return numberOfUpdates;
+    }
+
+    // Returns a copy of this network for writing its state on another thread (see RNN_Checkpoint.hpp).
+    // The copy shares the storage of this network but not its execution plan, so that updating this network
+    // afterwards does not copy the plan; the activation state is copied into the neurons of the copy instead.
+    NeuralNetwork snapshot(){
+      NeuralNetwork copy(*this);
+      copy.invalidatePlan();
+      copy.emptyPlan();
+      return copy;
+    }
+
+    // Writes the complete state of this network in binary form: topology including dead connection slots and the
+    // order of every connection list, parameters, activation state, settings and random number engine.
+    // A network read back with readState() continues with bit-identical updates and mutations. Not included are
+    // the threads of update() and, with an incremental update epsilon above zero, the changes held back so far.
+    bool writeState(std::ostream& output){
+      writeBinary(output, uint64_t(sizeof(scalar_t)));
+      writeBinary(output, uint64_t(sizeof(index_t)));
+      writeBinary(output, uint64_t(_nbOfInputs));
+      writeBinary(output, uint64_t(_nbOfOutputs));
+      writeBinary(output, uint64_t(_neurons.size()));
+      writeBinary(output, uint64_t(_connections.size()));
+      writeBinary(output, _minWeight);
+      writeBinary(output, _maxWeight);
+      writeBinary(output, _weightMutRate);
+      writeBinary(output, _neuronMutRate);
+      writeBinary(output, _addNeuronMutRate);
+      writeBinary(output, _addConnectionMutRate);
+      writeBinary(output, _compactionThreshold);
+      writeBinary(output, _updateEpsilon);
+      writeBinary(output, uint64_t(_reordering));
+      writeBinary(output, uint64_t(_reorderingInterval));
+      writeBinary(output, uint64_t(_nbOfNewNeurons));
+      writeBinary(output, uint64_t(_nbOfReorderings));
+      writeBinary(output, uint64_t(_incrementalUpdate));
+      writeBinary(output, uint64_t(_outputOnly));
+      writeBinary(output, uint64_t(_plan->getPrecision()));
+      const RandomEngine::State& rng = _rng.getState();
+      for(int i = 0; i < 4; i++){
+        writeBinary(output, rng.s[i]);
+      }
+      writeBinary(output, rng.spareGaussian);
+      writeBinary(output, uint64_t(rng.hasSpareGaussian));
+      // The activation state is held by the plan while it is valid.
+      for(size_t i = 0; i < _neurons.size(); i++){
+        const Neuron_t& neuron = _neurons[i];
+        writeBinary(output, _planDirty ? neuron.getValue() : _plan->getValue(i));
+        writeBinary(output, _planDirty ? neuron.getIncoming() : _plan->getIncoming(i));
+        writeBinary(output, neuron.getBias());
+        writeBinary(output, neuron.getLambda());
+        writeBinary(output, uint64_t(neuron.getActivationFunction()));
+      }
+      // Dead connections keep their sources and targets of Index_t(-1).
+      for(size_t i = 0; i < _connections.size(); i++){
+        writeBinary(output, uint64_t(_connections[i].getSource()));
+        writeBinary(output, uint64_t(_connections[i].getTarget()));
+        writeBinary(output, _connections[i].getWeight());
       }
-      actFile.close();
+      writeIndices(output, _freeConnections);
+      this->syncLists();
+      for(size_t i = 0; i < _neurons.size(); i++){
+        typename adjacency_t::List incoming = _incomingIndices.get(i);
+        typename adjacency_t::List outgoing = _outgoingIndices.get(i);
+        writeIndices(output, std::vector<index_t>(incoming.begin(), incoming.end()));
+        writeIndices(output, std::vector<index_t>(outgoing.begin(), outgoing.end()));
+      }
+      writeIndices(output, _permutation);
+      return bool(output);
+    }
+
+    // Replaces this network with the state written by writeState(). The threads of update() are kept.
+    // Returns false, leaving this network unchanged, if the state is malformed or of other scalar or index types.
+    bool readState(std::istream& input){
+      NeuralNetwork network(*this);
+      if(!network.readStateInto(input)){
+        std::cerr << "Invalid network state." << std::endl;
+        return false;
+      }
+      *this = std::move(network);
+      return true;
     }
 
   protected:
-    //Vectors containing neurons and connections.
-    std::vector<Neuron_t> _neurons;
-    std::vector<Connection_t> _connections;
+    // Replaces the contents of this network with the state written by writeState(). Returns false if it is malformed.
+    bool readStateInto(std::istream& input){
+      uint64_t scalarSize, indexSize, nbOfInputs, nbOfOutputs, nbOfNeurons, nbOfConnections;
+      if(!readBinary(input, scalarSize) || scalarSize != sizeof(scalar_t)) return false;
+      if(!readBinary(input, indexSize) || indexSize != sizeof(index_t)) return false;
+      if(!readBinary(input, nbOfInputs) || !readBinary(input, nbOfOutputs)) return false;
+      if(!readBinary(input, nbOfNeurons) || !readBinary(input, nbOfConnections)) return false;
+      if(nbOfInputs > nbOfNeurons || nbOfOutputs > nbOfNeurons - nbOfInputs) return false;
+      this->clear();
+      _nbOfInputs = nbOfInputs;
+      _nbOfOutputs = nbOfOutputs;
+      uint64_t reordering, reorderingInterval, nbOfNewNeurons, nbOfReorderings, incrementalUpdate, outputOnly, precision;
+      bool valid = readBinary(input, _minWeight) && readBinary(input, _maxWeight) &&
+                   readBinary(input, _weightMutRate) && readBinary(input, _neuronMutRate) &&
+                   readBinary(input, _addNeuronMutRate) && readBinary(input, _addConnectionMutRate) &&
+                   readBinary(input, _compactionThreshold) && readBinary(input, _updateEpsilon) &&
+                   readBinary(input, reordering) && readBinary(input, reorderingInterval) &&
+                   readBinary(input, nbOfNewNeurons) && readBinary(input, nbOfReorderings) &&
+                   readBinary(input, incrementalUpdate) && readBinary(input, outputOnly) && readBinary(input, precision);
+      if(!valid || reordering > reverseCuthillMcKee || precision > Activation::table) return false;
+      _reordering = reordering_t(reordering);
+      _reorderingInterval = reorderingInterval;
+      _nbOfNewNeurons = nbOfNewNeurons;
+      _nbOfReorderings = nbOfReorderings;
+      _incrementalUpdate = incrementalUpdate != 0;
+      _outputOnly = outputOnly != 0;
+      _plan.write().setPrecision(Activation::precision_t(precision));
+      RandomEngine::State rng;
+      uint64_t hasSpareGaussian;
+      for(int i = 0; i < 4; i++){
+        if(!readBinary(input, rng.s[i])) return false;
+      }
+      if(!readBinary(input, rng.spareGaussian) || !readBinary(input, hasSpareGaussian)) return false;
+      rng.hasSpareGaussian = hasSpareGaussian != 0;
+      _rng.setState(rng);
+      for(uint64_t i = 0; i < nbOfNeurons; i++){
+        scalar_t value, incoming, bias, lambda;
+        uint64_t activation;
+        if(!readBinary(input, value) || !readBinary(input, incoming) || !readBinary(input, bias) ||
+           !readBinary(input, lambda) || !readBinary(input, activation) || activation >= Neuron::nbActivationFunctions) return false;
+        Neuron_t neuron;
+        neuron.setValue(value);
+        neuron.setIncoming(incoming);
+        neuron.setBias(bias);
+        neuron.setLambda(lambda);
+        neuron.setActivationFunction(typename Neuron_t::af_t(activation));
+        _neurons.push_back(neuron);
+        _incomingIndices.addList();
+        _outgoingIndices.addList();
+      }
+      for(uint64_t i = 0; i < nbOfConnections; i++){
+        uint64_t source, target;
+        scalar_t weight;
+        if(!readBinary(input, source) || !readBinary(input, target) || !readBinary(input, weight)) return false;
+        Connection_t connection(source, target, weight);
+        if(connection.isAlive() && (source >= nbOfNeurons || target >= nbOfNeurons)) return false;
+        _connections.push_back(connection);
+      }
+      // Free connections must be dead and listed once. Every live connection must sit exactly once in the incoming
+      // list of its target and once in the outgoing list of its source, and nothing else may sit in the lists.
+      std::vector<uint8_t> seen(nbOfConnections, 0);
+      if(!readIndices(input, _freeConnections, nbOfConnections)) return false;
+      for(size_t j = 0; j < _freeConnections.size(); j++){
+        if(_connections[_freeConnections[j]].isAlive() || seen[_freeConnections[j]]) return false;
+        seen[_freeConnections[j]] = 1;
+      }
+      std::fill(seen.begin(), seen.end(), 0);
+      std::vector<index_t> indices;
+      for(uint64_t i = 0; i < nbOfNeurons; i++){
+        if(!readIndices(input, indices, nbOfConnections)) return false;
+        for(size_t j = 0; j < indices.size(); j++){
+          const Connection_t& connection = _connections[indices[j]];
+          if(!connection.isAlive() || uint64_t(connection.getTarget()) != i || (seen[indices[j]] & 1)) return false;
+          seen[indices[j]] |= 1;
+          _incomingIndices.append(i, indices[j]);
+        }
+        if(!readIndices(input, indices, nbOfConnections)) return false;
+        for(size_t j = 0; j < indices.size(); j++){
+          const Connection_t& connection = _connections[indices[j]];
+          if(!connection.isAlive() || uint64_t(connection.getSource()) != i || (seen[indices[j]] & 2)) return false;
+          seen[indices[j]] |= 2;
+          _outgoingIndices.append(i, indices[j]);
+        }
+      }
+      for(uint64_t i = 0; i < nbOfConnections; i++){
+        if(_connections[i].isAlive() && seen[i] != 3) return false;
+      }
+      return readIndices(input, _permutation, nbOfNeurons);
+    }
+
+    // Updates, logs and mutates the network for a given number of updates, or until the monitor detects convergence.
+    // Returns the number of updates performed.
+    size_t runSteps(size_t numberOfUpdates, TraceSink* sink, ConvergenceMonitor* monitor){
+      if(monitor) monitor->reset();
+      for(size_t i = 0; i < numberOfUpdates; i++){
+        this->update();
+        if(sink) this->logActivation(*sink);
+        bool changed = this->mutate();
+        if(!monitor) continue;
+        if(changed){
+          // The next update follows the new network; the current state starts a new history.
+          monitor->clearHistory();
+        }
+        const plan_t& plan = this->getExecutionPlan();
+        if(monitor->observe(plan.getValues().data(), plan.getIncomingValues().data(), plan.size()) == ConvergenceMonitor::running) continue;
+        size_t remaining = numberOfUpdates - i - 1;
+        if(monitor->getAction() == ConvergenceMonitor::fastForward && remaining > 0){
+          const double* values = monitor->getValues(remaining);
+          const double* incoming = monitor->getIncomingValues(remaining);
+          for(size_t j = 0; j < _neurons.size(); j++){
+            this->setValue(j, scalar_t(values[j]));
+            this->setIncoming(j, scalar_t(incoming[j]));
+          }
+          // mutate() then only draws from the random engine.
+          if(_weightMutRate == 0.0 && _neuronMutRate == 0.0 && _addNeuronMutRate == 0.0 && _addConnectionMutRate == 0.0){
+            for(size_t j = 0; j < remaining; j++){
+              this->mutate();
+            }
+          }
+          monitor->setSkippedSteps(remaining);
+        }
+        return i + 1;
+      }
+      return numberOfUpdates;
+    }
+
+    // Sets the input neurons of the compiled plan, updates the network and reads the output neurons.
+    void streamStep(plan_t& plan, const scalar_t* inputs, scalar_t* outputs){
+      for(size_t j = 0; j < _nbOfInputs; j++){
+        plan.setValue(j, inputs[j]);
+      }
+      this->update();
+      for(size_t j = 0; j < _nbOfOutputs; j++){
+        outputs[j] = plan.getValue(_nbOfInputs + j);
+      }
+    }
+
+    // Copies the activation values and incoming potentials held by the execution plan back into the neurons.
+    void syncNeurons(){
+      if(_planDirty || !_neuronsStale) return;
+      for(size_t i = 0; i < _neurons.size(); i++){
+        _neurons.write(i).setValue(_plan->getValue(i));
+        _neurons.write(i).setIncoming(_plan->getIncoming(i));
+      }
+      _neuronsStale = false;
+    }
+
+    // Returns true if update() leaves out the neurons without a path to an output (see setOutputOnly()).
+    bool isPruning(){
+      return _outputOnly && _addConnectionMutRate == 0.0;
+    }
+
+    // Recomputes the neurons with a path to an output neuron, if the topology changed in a way not tracked.
+    void updateLiveNeurons(){
+      if(!_liveStale) return;
+      this->syncLists();
+      _liveNeurons.assign(_neurons.size(), false);
+      for(size_t i = _nbOfInputs; i < _nbOfInputs + _nbOfOutputs && i < _neurons.size(); i++){
+        this->markLive(i);
+      }
+      _liveStale = false;
+    }
+
+    // Marks the indicated neuron and every neuron with a path to it as live.
+    void markLive(size_t neuronIndex){
+      if(_liveNeurons[neuronIndex]) return;
+      _liveNeurons[neuronIndex] = true;
+      std::vector<size_t> stack(1, neuronIndex);
+      while(!stack.empty()){
+        typename adjacency_t::List incomingConnections = _incomingIndices.get(stack.back());
+        stack.pop_back();
+        for(size_t j = 0; j < incomingConnections.size(); j++){
+          size_t source = _connections[incomingConnections[j]].getSource();
+          if(_liveNeurons[source]) continue;
+          _liveNeurons[source] = true;
+          stack.push_back(source);
+        }
+      }
+    }
+
+    // Returns true with the indicated probability: never at 0 and always at 1.
+    // One number is drawn whatever the probability, so the random stream does not depend on the mutation rates.
+    bool trial(double probability){
+      double draw = _rng.randDouble();
+      return draw < probability || probability >= 1.0;
+    }
+
+    // Returns the first index in [index, end) selected by independent trials with the indicated probability, or end.
+    // One geometric draw replaces the trials of all skipped indices, so mutate() costs O(mutations) rather than O(N + E).
+    size_t nextMutation(size_t index, size_t end, double rate){
+      size_t gap = _rng.randGeometric(rate);
+      return gap < end - index ? index + gap : end;
+    }
+
+    // Appends the unvisited hidden neighbours of a neuron to the order of reorderNeurons(), marking them visited.
+    // With degrees, the new neighbours are sorted by increasing degree as Cuthill-McKee requires.
+    void appendNeighbours(size_t neuronIndex, std::vector<size_t>& order, std::vector<char>& visited, const std::vector<size_t>& degree){
+      size_t first = order.size();
+      typename adjacency_t::List outgoing = _outgoingIndices.get(neuronIndex);
+      for(size_t i = 0; i < outgoing.size(); i++){
+        size_t target = _connections[outgoing[i]].getTarget();
+        if(visited[target]) continue;
+        visited[target] = 1;
+        order.push_back(target);
+      }
+      typename adjacency_t::List incoming = _incomingIndices.get(neuronIndex);
+      for(size_t i = 0; i < incoming.size(); i++){
+        size_t source = _connections[incoming[i]].getSource();
+        if(visited[source]) continue;
+        visited[source] = 1;
+        order.push_back(source);
+      }
+      if(!degree.empty()){
+        std::stable_sort(order.begin() + first, order.end(), [&degree](size_t a, size_t b){ return degree[a] < degree[b]; });
+      }
+    }
+
+    // Returns the execution plan for rebuilding. A plan still shared with a copy of this network is replaced by
+    // a new one with the same precision, rather than copied and then cleared.
+    plan_t& emptyPlan(){
+      if(_plan.isShared()){
+        Activation::precision_t precision = _plan->getPrecision();
+        _plan = CowPointer<plan_t>();
+        _plan.write().setPrecision(precision);
+      }
+      return _plan.write();
+    }
+
+    // Adds empty connection lists for neurons appended through getNeurons().
+    void syncLists(){
+      while(_incomingIndices.size() < _neurons.size()){
+        _incomingIndices.addList();
+        _outgoingIndices.addList();
+      }
+    }
+
+    // Marks the execution plan as out of date after the neurons become the only valid copy of the state.
+    void invalidatePlan(){
+      this->syncNeurons();
+      _planDirty = true;
+    }
+
+    //Vectors containing neurons and connections, in chunks shared with copies of this network until written.
+    neurons_t _neurons;
+    connections_t _connections;
+
+    // Indices of the incoming and outgoing connections of every neuron.
+    adjacency_t _incomingIndices;
+    adjacency_t _outgoingIndices;
+
+    // Indices of dead connections available for reuse, and the fraction of dead connections that triggers compaction.
+    std::vector<size_t> _freeConnections;
+    double _compactionThreshold;
+
+    // Automatic reordering of the hidden neurons (see setAutomaticReordering()) and the last permutation applied.
+    reordering_t _reordering;
+    size_t _reorderingInterval;
+    size_t _nbOfNewNeurons;
+    size_t _nbOfReorderings;
+    std::vector<size_t> _permutation;
 
     // Number of inputs and outputs.
     size_t _nbOfInputs;
@@ -361,19 +1238,51 @@ class NeuralNetwork{
     double _neuronMutRate;
     double _addNeuronMutRate;
     double _addConnectionMutRate;
+
+    // Random number engine used for randomization and mutation.
+    RandomEngine _rng;
+
+    // Compiled execution plan and its validity.
+    // While the plan is valid it holds the current activation values and incoming potentials.
+    // A copy of the network shares the plan until one of them writes to it, e.g. by an update.
+    CowPointer<plan_t> _plan;
+    bool _planDirty;
+    bool _neuronsStale;
+
+    // Update mode (see setIncrementalUpdate()).
+    bool _incrementalUpdate;
+    double _updateEpsilon;
+
+    // Threads of the parallel update, if any (see setThreads()).
+    std::shared_ptr<WorkerTeam> _team;
+
+    // Activation values converted to double for trace sinks, when the scalar type is not double.
+    std::vector<double> _traceRow;
+
+    // Input values pulled from a source by run().
+    std::vector<scalar_t> _inputRow;
+
+    // Output-only mode (see setOutputOnly()): the neurons with a path to an output, valid unless _liveStale.
+    bool _outputOnly;
+    bool _liveStale;
+    std::vector<bool> _liveNeurons;
 };
 
 // Convenience function for writing network connections to a file-stream.
-std::ostream& operator<<(std::ostream& is, NeuralNetwork<Neuron, Connection>& obj){
-  std::vector<Neuron> neurons = obj.getNeurons();
-  std::vector<Connection> connections = obj.getConnections();
+// See RNN_NetworkFile.hpp for a binary format that can be read back.
+template<typename Neuron_t, typename Connection_t>
+std::ostream& operator<<(std::ostream& is, NeuralNetwork<Neuron_t, Connection_t>& obj){
+  // Read through the const accessors, which leave the execution plan valid.
+  const NeuralNetwork<Neuron_t, Connection_t>& network = obj;
+  const typename NeuralNetwork<Neuron_t, Connection_t>::neurons_t& neurons = network.getNeurons();
+  const typename NeuralNetwork<Neuron_t, Connection_t>::connections_t& connections = network.getConnections();
   size_t nbOfInputs = obj.getInputs();
   size_t nbOfOutputs = obj.getOutputs();
 
   is << nbOfInputs << " ";
   is << nbOfOutputs << " ";
   is << neurons.size() << " ";
-  is << connections.size() << " ";
+  is << obj.getNbOfConnections() << " ";
 
   // Write neurons to file.
   for(size_t i=0; i<neurons.size(); ++i){
@@ -382,9 +1291,54 @@ std::ostream& operator<<(std::ostream& is, NeuralNetwork<Neuron, Connection>& ob
 
   // Write connections to file.
   for(size_t i=0; i<connections.size(); ++i){
+    if(!connections[i].isAlive()) continue;
     is << connections[i].getSource() << " " << connections[i].getTarget() << " "<< connections[i].getWeight()<< " ";
   }
   return is;
 }
 
+// Convenience function for reading a network written by operator<<.
+// The text format holds no activation functions or lambdas, so every neuron keeps the defaults of addNeuron().
+// Weights and biases are read back with the precision they were written with; set the precision of the
+// writing stream to std::numeric_limits<double>::max_digits10 to read back the exact values.
+// On malformed input the failbit of the stream is set and the network is left empty.
+template<typename Neuron_t, typename Connection_t>
+std::istream& operator>>(std::istream& is, NeuralNetwork<Neuron_t, Connection_t>& obj){
+  typedef typename Neuron_t::scalar_t scalar_t;
+  size_t nbOfInputs, nbOfOutputs, nbOfNeurons, nbOfConnections;
+  obj.clear();
+  if(!(is >> nbOfInputs >> nbOfOutputs >> nbOfNeurons >> nbOfConnections)) return is;
+  if(nbOfInputs + nbOfOutputs > nbOfNeurons){
+    std::cerr << "Invalid network: " << nbOfNeurons << " neurons for " << nbOfInputs << " inputs and " << nbOfOutputs << " outputs" << std::endl;
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  obj.reserve(nbOfNeurons, nbOfConnections);
+  obj.setInputs(nbOfInputs);
+  obj.setOutputs(nbOfOutputs);
+
+  // Read neurons from file.
+  for(size_t i=0; i<nbOfNeurons; ++i){
+    double bias;
+    if(!(is >> bias)) break;
+    obj.addNeuron();
+    obj.setBias(i, scalar_t(bias));
+  }
+
+  // Read connections from file.
+  for(size_t i=0; i<nbOfConnections && is; ++i){
+    size_t source, target;
+    double weight;
+    if(!(is >> source >> target >> weight)) break;
+    if(source >= nbOfNeurons || target >= nbOfNeurons){
+      std::cerr << "Invalid connection: " << source << " -> " << target << std::endl;
+      is.setstate(std::ios::failbit);
+      break;
+    }
+    obj.addConnection(source, target, scalar_t(weight));
+  }
+  if(!is) obj.clear();
+  return is;
+}
+
 #endif /* RNN_NEURALNETWORK_HPP_ */
@@ -10,9 +10,14 @@
 
 // Standard libraries
 #include <cmath>
+#include <cstddef>
+#include <iostream>
 
-// A neuron class for neural networks.
-class Neuron{
+// Local libraries
+#include "Misc_FixedPoint.hpp"
+
+// Activation functions shared by neurons of every scalar type.
+class NeuronBase{
   public:
     // Enumerator for the different possible activation functions.
     // - linear: identity, except that it truncates values to lie in [-1, 1]
@@ -26,9 +31,43 @@ class Neuron{
       sigmoid,
       nbActivationFunctions
     };
+
+    // Returns the output of the indicated activation function for the supplied potential.
+    template<typename Scalar_t>
+    static Scalar_t activate(af_t activation, Scalar_t x, Scalar_t lambda){
+      using std::exp;
+      using std::sin;
+      using std::tanh;
+      switch(activation){
+        case linear:
+          if(x > Scalar_t(1)) return Scalar_t(1);
+          else if(x < Scalar_t(-1)) return Scalar_t(-1);
+          else return x;
+        case sine:
+          return sin(x);
+        case gaussian:
+          return exp(-x*x) * Scalar_t(2) - Scalar_t(1);
+        case sigmoid:
+          return tanh(x * lambda);
+        default:
+          std::cout << "Error! No activation function found!" << std::endl;
+          return Scalar_t(0);
+      }
+    }
+};
+
+// A neuron class for neural networks.
+// Values, biases and lambda are stored as Scalar_t. The lists of connection indices of a neuron are kept by
+// the network in an AdjacencyArena of Index_t (see RNN_AdjacencyArena.hpp), so a neuron owns no heap storage.
+template<typename Scalar_t = double, typename Index_t = size_t>
+class BasicNeuron : public NeuronBase{
+  public:
+    typedef Scalar_t scalar_t;
+    typedef Index_t index_t;
+
     // Constructor. Creates a new neuron with the indicated number of incoming connection.
     // The current and new activations are initialized to zero.
-    Neuron():
+    BasicNeuron():
       _value(0),
       _incoming(0),
       _bias(0),
@@ -37,88 +76,49 @@ class Neuron{
     }
 
     // Return the current activation value of this neuron.
-    double getValue(){
+    Scalar_t getValue() const{
       return _value;
     }
 
     // Sets the current value.
-    void setValue(double value){
+    void setValue(Scalar_t value){
       _value = value;
     }
 
     // Returns the current amount of incoming potential.
-    const double& getIncoming(){
+    const Scalar_t& getIncoming() const{
       return _incoming;
     }
 
     // Sets the amount of incoming potential.
-    void setIncoming(double incoming){
+    void setIncoming(Scalar_t incoming){
       _incoming = incoming;
     }
 
     // Adds the supplied value to the current incoming potential.
-    void updateIncoming(double update){
+    void updateIncoming(Scalar_t update){
       _incoming += update;
     }
 
     // Returns the bias of this neuron.
-    double getBias(){
+    Scalar_t getBias() const{
       return _bias;
     }
 
     // Sets the bias of this neuron.
-    void setBias(double bias){
+    void setBias(Scalar_t bias){
       _bias = bias;
     }
 
-    // Adds the index of an incoming connection.
-    void addIncoming(size_t incoming){
-      _incomingIndices.push_back(incoming);
-    }
-
-    // Adds the index of an outgoing connection.
-    void addOutgoing(size_t outgoing){
-      _outgoingIndices.push_back(outgoing);
-    }
-
-    // Returns the vector of incoming connection indices.
-    const std::vector<size_t>& getIncomingIndices(){
-      return _incomingIndices;
-    }
-
-    // Returns the vector of outgoing connection indices.
-    const std::vector<size_t>& getOutgoingIndices(){
-      return _outgoingIndices;
-    }
-
     // Resets the state of this neuron.
     void reset(){
-      _value = 0;
-      _incoming = 0;
+      _value = Scalar_t(0);
+      _incoming = Scalar_t(0);
     }
 
     // Updates the activation value based on the incoming potential and the bias.
     void propagate(){
-      double x = this->getIncoming() + this->getBias();
-      switch(_activationFunction){
-        case linear:
-          if(x > 1) _value = 1;
-          else if(x < -1) _value = -1;
-          else _value = x;
-          break;
-        case sine:
-          _value = std::sin(x);
-          break;
-        case gaussian:
-          _value = std::exp(float(-x*x)) * 2.0 - 1.0;
-          break;
-        case sigmoid:
-          _value = std::tanh(x * _lambda);
-          break;
-        default:
-          std::cout << "Error! No activation function found!" << std::endl;
-          break;
-      }
+      _value = activate(_activationFunction, this->getIncoming() + this->getBias(), _lambda);
     }
 
     // Sets the current activation function.
@@ -132,19 +132,30 @@ class Neuron{
     }
 
     // Returns the current activation function.
-    af_t getActivationFunction(){
+    af_t getActivationFunction() const{
       return _activationFunction;
     }
 
+    // Returns the steepness of the sigmoid activation function.
+    Scalar_t getLambda() const{
+      return _lambda;
+    }
+
+    // Sets the steepness of the sigmoid activation function.
+    void setLambda(Scalar_t lambda){
+      _lambda = lambda;
+    }
+
   protected:
     // ANN attributes
     af_t _activationFunction;
-    std::vector<size_t> _incomingIndices;
-    std::vector<size_t> _outgoingIndices;
-    double _value;
-    double _incoming;
-    double _bias;
-    double _lambda;
+    Scalar_t _value;
+    Scalar_t _incoming;
+    Scalar_t _bias;
+    Scalar_t _lambda;
 };
 
+// The default neuron, with double precision values and size_t connection indices.
+typedef BasicNeuron<double, size_t> Neuron;
+
 #endif /* RNN_NEURON_HPP_ */
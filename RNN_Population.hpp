@@ -0,0 +1,288 @@
+/*
+ * RNN_Population.hpp
+ *
+ * Revision: October 2026
+ *
+ * A population of neural networks that is evaluated and evolved in parallel.
+ */
+
+#ifndef RNN_POPULATION_HPP_
+#define RNN_POPULATION_HPP_
+
+// Standard libraries
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+// Local libraries
+#include "Misc_BinaryStream.hpp"
+#include "Misc_Random.hpp"
+#include "Misc_ThreadPool.hpp"
+#include "RNN_NeuralNetwork.hpp"
+
+// A population of neural networks evolved by tournament selection and mutation.
+// Evaluation, cloning and mutation of the individuals run concurrently on a fixed thread pool.
+// Every task on an individual draws from its own random stream, obtained by jumping an engine
+// seeded from the population seed and the generation, so results do not depend on the number of threads.
+template<typename Network_t = NeuralNetwork<> >
+class Population{
+  public:
+    // Function returning the fitness of a network (higher is better).
+    typedef std::function<double(Network_t&)> fitness_t;
+
+    // Everything an evolution resumes from: the individuals, their fitness, the generation and the settings.
+    // The random streams are derived from the seed and the generation, so they need not be stored.
+    struct State{
+      // Writes the state in binary form (see NeuralNetwork::writeState()).
+      bool writeState(std::ostream& output){
+        writeBinary(output, seed);
+        writeBinary(output, uint64_t(generation));
+        writeBinary(output, uint64_t(numberOfUpdates));
+        writeBinary(output, uint64_t(eliteCount));
+        writeBinary(output, uint64_t(tournamentSize));
+        writeBinary(output, uint64_t(individuals.size()));
+        for(size_t i = 0; i < individuals.size(); i++){
+          writeBinary(output, fitness[i]);
+          if(!individuals[i].writeState(output)) return false;
+        }
+        return bool(output);
+      }
+
+      std::vector<Network_t> individuals;
+      std::vector<double> fitness;
+      uint64_t seed;
+      size_t generation;
+      size_t numberOfUpdates;
+      size_t eliteCount;
+      size_t tournamentSize;
+    };
+
+    // Constructor. Creates a population of copies of the supplied prototype.
+    // The evaluation uses the indicated number of threads (one per hardware thread if 0).
+    Population(const Network_t& prototype, size_t size, size_t nbOfThreads = 0):
+      _individuals(size, prototype),
+      _offspring(size, prototype),
+      _fitness(size, 0.0),
+      _pool(nbOfThreads),
+      _seed(0),
+      _generation(0),
+      _numberOfUpdates(0),
+      _eliteCount(1),
+      _tournamentSize(3){
+    }
+
+    // Sets the seed from which every random stream of the population is derived.
+    void setSeed(uint64_t seed){
+      _seed = seed;
+    }
+
+    // Sets the function used to score each network.
+    void setFitnessFunction(fitness_t fitnessFunction){
+      _fitnessFunction = fitnessFunction;
+    }
+
+    // Sets the number of updates performed on each network before it is scored.
+    void setNumberOfUpdates(size_t numberOfUpdates){
+      _numberOfUpdates = numberOfUpdates;
+    }
+
+    // Sets the number of best individuals copied unchanged into the next generation.
+    void setEliteCount(size_t eliteCount){
+      _eliteCount = eliteCount;
+    }
+
+    // Sets the number of individuals competing in each tournament selection.
+    void setTournamentSize(size_t tournamentSize){
+      _tournamentSize = tournamentSize;
+    }
+
+    // Returns the number of individuals.
+    size_t size(){
+      return _individuals.size();
+    }
+
+    // Returns the number of worker threads.
+    size_t getThreads(){
+      return _pool.size();
+    }
+
+    // Returns the current generation.
+    size_t getGeneration(){
+      return _generation;
+    }
+
+    // Returns the indicated individual.
+    Network_t& getIndividual(size_t index){
+      return _individuals[index];
+    }
+
+    // Returns the fitness of the indicated individual from the last evaluation.
+    double getFitness(size_t index){
+      return _fitness[index];
+    }
+
+    // Returns the index of the individual with the highest fitness.
+    size_t getBestIndex(){
+      size_t best = 0;
+      for(size_t i = 1; i < _fitness.size(); i++){
+        if(_fitness[i] > _fitness[best]) best = i;
+      }
+      return best;
+    }
+
+    // Randomizes the biases and weights of every individual.
+    void randomize(){
+      this->createStreams(0);
+      _pool.parallelFor(0, _individuals.size(), [this](size_t i){
+        _individuals[i].setRandomEngine(_streams[i]);
+        _individuals[i].randomize();
+      });
+    }
+
+    // Runs and scores every individual.
+    void evaluate(){
+      this->createStreams(1);
+      _pool.parallelFor(0, _individuals.size(), [this](size_t i){
+        generator() = _streams[i];
+        Network_t& network = _individuals[i];
+        for(size_t j = 0; j < _numberOfUpdates; j++){
+          network.update();
+        }
+        _fitness[i] = _fitnessFunction ? _fitnessFunction(network) : 0.0;
+      });
+    }
+
+    // Replaces the population with the next generation.
+    // The elite is kept unchanged. Every other offspring is a mutated clone of a tournament winner.
+    void reproduce(){
+      size_t size = _individuals.size();
+      std::vector<size_t> order(size);
+      for(size_t i = 0; i < size; i++) order[i] = i;
+      std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b){ return _fitness[a] > _fitness[b]; });
+      size_t eliteCount = std::min(_eliteCount, size);
+      // Parents are chosen on the calling thread from a stream derived from the generation.
+      std::vector<size_t> parents(size);
+      RandomEngine selection(mix(_seed ^ mix(_generation)));
+      for(size_t i = 0; i < size; i++){
+        if(i < eliteCount){
+          parents[i] = order[i];
+          continue;
+        }
+        size_t winner = selection() % size;
+        for(size_t j = 1; j < _tournamentSize; j++){
+          size_t challenger = selection() % size;
+          if(_fitness[challenger] > _fitness[winner]) winner = challenger;
+        }
+        parents[i] = winner;
+      }
+      // Offspring share the storage of their parents and copy only the chunks that mutate() writes to.
+      this->createStreams(2);
+      _pool.parallelFor(0, size, [this, &parents, eliteCount](size_t i){
+        _offspring[i] = _individuals[parents[i]];
+        _offspring[i].setRandomEngine(_streams[i]);
+        if(i >= eliteCount) _offspring[i].mutate();
+      });
+      _individuals.swap(_offspring);
+      _generation++;
+    }
+
+    // Evaluates and reproduces the population for the indicated number of generations,
+    // and evaluates the final generation.
+    void evolve(size_t generations){
+      for(size_t i = 0; i < generations; i++){
+        this->evaluate();
+        this->reproduce();
+      }
+      this->evaluate();
+    }
+
+    // Returns the state of the population for writing it on another thread, e.g. by a CheckpointWriter.
+    // The individuals are snapshots sharing the storage of the population (see NeuralNetwork::snapshot()).
+    State snapshot(){
+      State state;
+      state.individuals.reserve(_individuals.size());
+      for(size_t i = 0; i < _individuals.size(); i++){
+        state.individuals.push_back(_individuals[i].snapshot());
+      }
+      state.fitness = _fitness;
+      state.seed = _seed;
+      state.generation = _generation;
+      state.numberOfUpdates = _numberOfUpdates;
+      state.eliteCount = _eliteCount;
+      state.tournamentSize = _tournamentSize;
+      return state;
+    }
+
+    // Writes the state of the population in binary form. Evolving a population read back with readState()
+    // gives bit-identical results, provided it has the same fitness function.
+    bool writeState(std::ostream& output){
+      return this->snapshot().writeState(output);
+    }
+
+    // Replaces the individuals, fitness, generation and settings with those written by writeState().
+    // The fitness function and the threads are kept. Returns false, leaving the population unchanged, on failure.
+    bool readState(std::istream& input){
+      State state;
+      uint64_t generation, numberOfUpdates, eliteCount, tournamentSize, size;
+      if(!readBinary(input, state.seed) || !readBinary(input, generation) || !readBinary(input, numberOfUpdates) ||
+         !readBinary(input, eliteCount) || !readBinary(input, tournamentSize) || !readBinary(input, size)){
+        std::cerr << "Invalid population state." << std::endl;
+        return false;
+      }
+      for(uint64_t i = 0; i < size; i++){
+        double fitness;
+        if(!readBinary(input, fitness)){
+          std::cerr << "Invalid population state." << std::endl;
+          return false;
+        }
+        state.fitness.push_back(fitness);
+        state.individuals.push_back(_individuals.empty() ? Network_t() : _individuals[0]);
+        if(!state.individuals.back().readState(input)) return false;
+      }
+      _individuals.swap(state.individuals);
+      _offspring = _individuals;
+      _fitness.swap(state.fitness);
+      _seed = state.seed;
+      _generation = generation;
+      _numberOfUpdates = numberOfUpdates;
+      _eliteCount = eliteCount;
+      _tournamentSize = tournamentSize;
+      return true;
+    }
+
+  protected:
+    // SplitMix64 finalizer, used to derive independent seeds.
+    static uint64_t mix(uint64_t x){
+      x += 0x9E3779B97F4A7C15ULL;
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+      return x ^ (x >> 31);
+    }
+
+    // Creates one random stream per individual for the indicated phase of the current generation.
+    void createStreams(uint64_t phase){
+      RandomEngine engine(mix(_seed ^ mix(_generation ^ mix(phase))));
+      _streams.resize(_individuals.size());
+      for(size_t i = 0; i < _streams.size(); i++){
+        _streams[i] = engine;
+        engine.jump();
+      }
+    }
+
+    std::vector<Network_t> _individuals;
+    std::vector<Network_t> _offspring;
+    std::vector<double> _fitness;
+    std::vector<RandomEngine> _streams;
+    fitness_t _fitnessFunction;
+    ThreadPool _pool;
+
+    uint64_t _seed;
+    size_t _generation;
+    size_t _numberOfUpdates;
+    size_t _eliteCount;
+    size_t _tournamentSize;
+};
+
+#endif /* RNN_POPULATION_HPP_ */
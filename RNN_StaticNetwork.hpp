@@ -0,0 +1,180 @@
+/*
+ * RNN_StaticNetwork.hpp
+ *
+ * Revision: October 2026
+ *
+ * A fixed-topology network whose sizes and activation function are template parameters.
+ */
+
+#ifndef RNN_STATICNETWORK_HPP_
+#define RNN_STATICNETWORK_HPP_
+
+// Standard libraries
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+// Local libraries
+#include "RNN_NeuralNetwork.hpp"
+#include "RNN_Neuron.hpp"
+
+// A frozen network for deployment, loaded from a trained NeuralNetwork.
+// All storage is in std::array members, so the network never allocates. Every neuron uses the activation
+// function given as template parameter, which removes the runtime dispatch, and the loop over neurons is
+// unrolled at compile time. The connections keep the order of the execution plan of the source network,
+// so update() gives the same values as NeuralNetwork::update().
+template<size_t Inputs, size_t Outputs, size_t Hidden, size_t MaxConnections,
+         NeuronBase::af_t Activation = NeuronBase::sigmoid, typename Scalar_t = double>
+class StaticNetwork{
+  public:
+    typedef Scalar_t scalar_t;
+
+    // Number of neurons and maximum number of connections.
+    static constexpr size_t nbOfInputs = Inputs;
+    static constexpr size_t nbOfOutputs = Outputs;
+    static constexpr size_t nbOfNeurons = Inputs + Outputs + Hidden;
+    static constexpr size_t maxConnections = MaxConnections;
+
+    // Smallest index types that can hold every neuron and connection index.
+    typedef typename std::conditional<(nbOfNeurons <= 0xFFFF), uint16_t, uint32_t>::type neuron_index_t;
+    typedef typename std::conditional<(MaxConnections <= 0xFFFF), uint16_t, uint32_t>::type connection_index_t;
+
+    // Constructor. Creates a network without connections and with all values at zero.
+    StaticNetwork():
+      _nbOfConnections(0){
+      _offsets.fill(0);
+      _sources.fill(0);
+      _weights.fill(Scalar_t(0));
+      _values.fill(Scalar_t(0));
+      _incoming.fill(Scalar_t(0));
+      _biases.fill(Scalar_t(0));
+      _lambdas.fill(Scalar_t(0));
+    }
+
+    // Constructor. Copies the topology, parameters and state of the supplied network (see load()).
+    template<typename Neuron_t, typename Connection_t>
+    explicit StaticNetwork(NeuralNetwork<Neuron_t, Connection_t>& network):
+      StaticNetwork(){
+      this->load(network);
+    }
+
+    // Copies the topology, parameters and current state of the supplied network.
+    // Returns false, leaving this network unchanged, if the network does not match the template parameters or if
+    // its execution plan leaves pruned neurons out (see NeuralNetwork::setOutputOnly()), since this network would
+    // compute them instead of keeping their values.
+    template<typename Neuron_t, typename Connection_t>
+    bool load(NeuralNetwork<Neuron_t, Connection_t>& network){
+      if(network.getInputs() != Inputs || network.getOutputs() != Outputs || network.getNbOfNeurons() != nbOfNeurons){
+        std::cerr << "Network size does not match: " << network.getInputs() << " inputs, " << network.getOutputs()
+                  << " outputs, " << network.getNbOfNeurons() << " neurons" << std::endl;
+        return false;
+      }
+      const typename NeuralNetwork<Neuron_t, Connection_t>::plan_t& plan = network.getExecutionPlan();
+      if(plan.getNbOfComputedNeurons() != plan.size()){
+        std::cerr << "Network prunes " << plan.size() - plan.getNbOfComputedNeurons()
+                  << " neurons; load it with setOutputOnly(false)" << std::endl;
+        return false;
+      }
+      if(plan.nbOfConnections() > MaxConnections){
+        std::cerr << "Too many connections: " << plan.nbOfConnections() << " > " << MaxConnections << std::endl;
+        return false;
+      }
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        if(plan.getActivationFunctions()[i] != Activation){
+          std::cerr << "Activation function of neuron " << i << " does not match" << std::endl;
+          return false;
+        }
+      }
+      _nbOfConnections = plan.nbOfConnections();
+      for(size_t i = 0; i <= nbOfNeurons; i++){
+        _offsets[i] = connection_index_t(plan.getOffsets()[i]);
+      }
+      for(size_t j = 0; j < _nbOfConnections; j++){
+        _sources[j] = neuron_index_t(plan.getSources()[j]);
+        _weights[j] = Scalar_t(plan.getWeights()[j]);
+      }
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        _values[i] = Scalar_t(plan.getValues()[i]);
+        _incoming[i] = Scalar_t(plan.getIncomingValues()[i]);
+        _biases[i] = Scalar_t(plan.getBiases()[i]);
+        _lambdas[i] = Scalar_t(plan.getLambdas()[i]);
+      }
+      return true;
+    }
+
+    // Performs one update of network activation.
+    void update(){
+      this->accumulate(std::make_index_sequence<nbOfNeurons>());
+      this->propagate(std::make_index_sequence<nbOfNeurons>());
+    }
+
+    // Returns the number of connections.
+    size_t getNbOfConnections() const{
+      return _nbOfConnections;
+    }
+
+    // Sets the activation value of the indicated neuron.
+    void setValue(size_t neuronIndex, Scalar_t value){
+      _values[neuronIndex] = value;
+    }
+
+    // Returns the activation value of the indicated neuron.
+    Scalar_t getValue(size_t neuronIndex) const{
+      return _values[neuronIndex];
+    }
+
+    // Returns the activation value of the indicated output neuron.
+    Scalar_t getOutputValue(size_t neuronIndex) const{
+      return _values[neuronIndex + Inputs];
+    }
+
+    // Returns the activation values of all neurons.
+    const std::array<Scalar_t, nbOfNeurons>& getValues() const{
+      return _values;
+    }
+
+    // Resets the state of all neurons.
+    void reset(){
+      _values.fill(Scalar_t(0));
+      _incoming.fill(Scalar_t(0));
+    }
+
+  protected:
+    // Computes the incoming potential of every neuron, one expansion per neuron.
+    template<size_t... I>
+    void accumulate(std::index_sequence<I...>){
+      ((_incoming[I] = this->sum(I)), ...);
+    }
+
+    // Returns the weighted sum of the incoming connections of the indicated neuron.
+    Scalar_t sum(size_t neuronIndex) const{
+      Scalar_t sum = Scalar_t(0);
+      for(size_t j = _offsets[neuronIndex]; j < _offsets[neuronIndex + 1]; j++){
+        sum += _values[_sources[j]] * _weights[j];
+      }
+      return sum;
+    }
+
+    // Propagates the incoming potential of every neuron with the compile-time activation function.
+    template<size_t... I>
+    void propagate(std::index_sequence<I...>){
+      ((_values[I] = NeuronBase::activate(Activation, _incoming[I] + _biases[I], _lambdas[I])), ...);
+    }
+
+    // CSR topology.
+    size_t _nbOfConnections;
+    std::array<connection_index_t, nbOfNeurons + 1> _offsets;
+    std::array<neuron_index_t, MaxConnections> _sources;
+    std::array<Scalar_t, MaxConnections> _weights;
+
+    // Neuron state and parameters.
+    std::array<Scalar_t, nbOfNeurons> _values;
+    std::array<Scalar_t, nbOfNeurons> _incoming;
+    std::array<Scalar_t, nbOfNeurons> _biases;
+    std::array<Scalar_t, nbOfNeurons> _lambdas;
+};
+
+#endif /* RNN_STATICNETWORK_HPP_ */
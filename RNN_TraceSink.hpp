@@ -0,0 +1,324 @@
+/*
+ * RNN_TraceSink.hpp
+ *
+ * Revision: October 2026
+ *
+ * Destinations for the activation trace written by NeuralNetwork::run().
+ */
+
+#ifndef RNN_TRACESINK_HPP_
+#define RNN_TRACESINK_HPP_
+
+// Standard libraries
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local libraries
+#include "RNN_Instrumentation.hpp"
+
+// Receives one row of activation values per network update.
+class TraceSink{
+  public:
+    virtual ~TraceSink(){}
+
+    // Records the activation values of all neurons after one update.
+    virtual void write(const double* values, size_t n) = 0;
+
+    // Writes any buffered rows to their destination.
+    virtual void flush(){}
+
+    // Returns the number of bytes written to the destination so far.
+    virtual size_t getBytesWritten() const = 0;
+};
+
+// Writes the trace as text: one line per update with space-separated values.
+// The output matches the format of std::ostream with its default precision.
+class TextTraceSink : public TraceSink{
+  public:
+    // Constructor. Opens the indicated file and uses a buffer of the indicated size in bytes.
+    explicit TextTraceSink(const std::string& fileName, size_t bufferSize = 1 << 20):
+      _file(fileName.c_str(), std::ios::binary),
+      _bytesWritten(0){
+      _buffer.reserve(bufferSize);
+      if(!_file.is_open()){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+      }
+    }
+
+    // Destructor. Flushes the buffered text.
+    ~TextTraceSink(){
+      this->flush();
+    }
+
+    // Formats one row into the buffer.
+    void write(const double* values, size_t n){
+      // Every value needs at most 13 characters in general format with precision 6, plus a separator.
+      if(_buffer.size() + n * maxLength + 1 > _buffer.capacity()) this->flush();
+      size_t size = _buffer.size();
+      _buffer.resize(size + n * maxLength + 1);
+      char* first = &_buffer[size];
+      char* last = _buffer.data() + _buffer.size();
+      for(size_t i = 0; i < n; i++){
+        if(i > 0) *first++ = ' ';
+        first = std::to_chars(first, last, values[i], std::chars_format::general, 6).ptr;
+      }
+      *first++ = '\n';
+      RNN_COUNT(bytesLogged, first - &_buffer[size]);
+      _buffer.resize(first - _buffer.data());
+    }
+
+    // Writes the buffered text to the file.
+    void flush(){
+      if(_file.is_open() && !_buffer.empty()){
+        _file.write(_buffer.data(), _buffer.size());
+        _file.flush();
+        _bytesWritten += _buffer.size();
+      }
+      _buffer.clear();
+    }
+
+    // Returns the number of bytes written to the file so far.
+    size_t getBytesWritten() const{
+      return _bytesWritten;
+    }
+
+  protected:
+    static constexpr size_t maxLength = 14;
+
+    std::ofstream _file;
+    std::vector<char> _buffer;
+    size_t _bytesWritten;
+};
+
+// Writes the trace in a binary columnar format.
+// The file starts with the magic "RNNT" and a 32-bit version, followed by blocks.
+// Each block has a 64-bit row count and column count and then the values column by column,
+// so that the trace of one neuron over the rows of a block is contiguous.
+// A new block starts whenever the buffer is full or the number of neurons changes.
+class BinaryTraceSink : public TraceSink{
+  public:
+    // Current version of the format.
+    static constexpr uint32_t version = 1;
+
+    // Constructor. Opens the indicated file and buffers up to the indicated number of rows per block.
+    explicit BinaryTraceSink(const std::string& fileName, size_t rowsPerBlock = 4096):
+      _file(fileName.c_str(), std::ios::binary),
+      _rowsPerBlock(rowsPerBlock),
+      _columns(0),
+      _bytesWritten(0){
+      if(!_file.is_open()){
+        std::cerr << "Could not open file: " << fileName << std::endl;
+        return;
+      }
+      _file.write("RNNT", 4);
+      _file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+      _bytesWritten += 4 + sizeof(version);
+    }
+
+    // Destructor. Writes the last block.
+    ~BinaryTraceSink(){
+      this->flush();
+    }
+
+    // Appends one row to the current block.
+    void write(const double* values, size_t n){
+      if(n != _columns || _rows.size() >= _rowsPerBlock * _columns){
+        this->writeBlock();
+        _columns = n;
+        _rows.reserve(_rowsPerBlock * n);
+      }
+      _rows.insert(_rows.end(), values, values + n);
+      RNN_COUNT(bytesLogged, n * sizeof(double));
+    }
+
+    // Writes the current block to the file.
+    void flush(){
+      this->writeBlock();
+      if(_file.is_open()) _file.flush();
+    }
+
+    // Returns the number of bytes written to the file so far.
+    size_t getBytesWritten() const{
+      return _bytesWritten;
+    }
+
+  protected:
+    // Transposes the buffered rows into columns and writes them as one block.
+    void writeBlock(){
+      if(_rows.empty() || _columns == 0 || !_file.is_open()){
+        _rows.clear();
+        return;
+      }
+      uint64_t shape[2] = {_rows.size() / _columns, _columns};
+      _block.resize(_rows.size());
+      for(size_t i = 0; i < shape[0]; i++){
+        for(size_t j = 0; j < shape[1]; j++){
+          _block[j * shape[0] + i] = _rows[i * shape[1] + j];
+        }
+      }
+      _file.write(reinterpret_cast<const char*>(shape), sizeof(shape));
+      _file.write(reinterpret_cast<const char*>(_block.data()), _block.size() * sizeof(double));
+      _bytesWritten += sizeof(shape) + _block.size() * sizeof(double);
+      _rows.clear();
+    }
+
+    std::ofstream _file;
+    size_t _rowsPerBlock;
+    size_t _columns;
+    size_t _bytesWritten;
+    std::vector<double> _rows;
+    std::vector<double> _block;
+};
+
+// Forwards the trace to another sink from a background thread.
+// Rows are copied into reusable chunks; full chunks pass through a bounded queue to the writer thread,
+// so the caller only waits if the writer falls more than the queue capacity behind.
+class AsyncTraceSink : public TraceSink{
+  public:
+    // Constructor. Takes ownership of the supplied sink.
+    // Rows are grouped in chunks of the indicated number of values, and at most the indicated number of chunks are queued.
+    explicit AsyncTraceSink(std::unique_ptr<TraceSink> sink, size_t chunkSize = 1 << 16, size_t queueCapacity = 8):
+      _sink(std::move(sink)),
+      _chunkSize(chunkSize),
+      _queueCapacity(queueCapacity),
+      _stalls(0),
+      _bytesWritten(0),
+      _busy(false),
+      _stop(false){
+      _current = this->acquireChunk();
+      _writer = std::thread(&AsyncTraceSink::writerLoop, this);
+    }
+
+    // Destructor. Writes every queued row and stops the writer thread.
+    ~AsyncTraceSink(){
+      this->flush();
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _queueChanged.notify_all();
+      _writer.join();
+    }
+
+    // Copies one row into the current chunk.
+    void write(const double* values, size_t n){
+      if(!_current->values.empty() && _current->values.size() + n > _chunkSize){
+        this->submit();
+      }
+      _current->values.insert(_current->values.end(), values, values + n);
+      _current->rowSizes.push_back(n);
+    }
+
+    // Hands the current chunk to the writer thread and waits until everything has been written.
+    void flush(){
+      if(!_current->rowSizes.empty()) this->submit();
+      std::unique_lock<std::mutex> lock(_mutex);
+      _queueChanged.wait(lock, [this]{ return _queue.empty() && !_busy; });
+      _sink->flush();
+      _bytesWritten = _sink->getBytesWritten();
+    }
+
+    // Returns the number of bytes written by the wrapped sink so far.
+    size_t getBytesWritten() const{
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _bytesWritten;
+    }
+
+    // Returns the number of times write() had to wait for the writer thread.
+    size_t getStalls() const{
+      return _stalls;
+    }
+
+  protected:
+    // A group of rows stored back to back.
+    struct Chunk{
+      std::vector<double> values;
+      std::vector<size_t> rowSizes;
+    };
+
+    // Returns an empty chunk, reusing a previously written one if available.
+    std::unique_ptr<Chunk> acquireChunk(){
+      std::unique_ptr<Chunk> chunk;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_free.empty()){
+          chunk = std::move(_free.back());
+          _free.pop_back();
+        }
+      }
+      if(!chunk){
+        chunk.reset(new Chunk());
+        chunk->values.reserve(_chunkSize);
+      }
+      return chunk;
+    }
+
+    // Queues the current chunk, waiting if the queue is full.
+    void submit(){
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if(_queue.size() >= _queueCapacity){
+          _stalls++;
+          _queueChanged.wait(lock, [this]{ return _queue.size() < _queueCapacity; });
+        }
+        _queue.push_back(std::move(_current));
+      }
+      _queueChanged.notify_all();
+      _current = this->acquireChunk();
+    }
+
+    // Main loop of the writer thread.
+    void writerLoop(){
+      std::unique_lock<std::mutex> lock(_mutex);
+      while(true){
+        _queueChanged.wait(lock, [this]{ return _stop || !_queue.empty(); });
+        if(_queue.empty()) return;
+        std::unique_ptr<Chunk> chunk = std::move(_queue.front());
+        _queue.pop_front();
+        _busy = true;
+        lock.unlock();
+        _queueChanged.notify_all();
+        const double* values = chunk->values.data();
+        for(size_t i = 0; i < chunk->rowSizes.size(); i++){
+          _sink->write(values, chunk->rowSizes[i]);
+          values += chunk->rowSizes[i];
+        }
+        chunk->values.clear();
+        chunk->rowSizes.clear();
+        size_t bytesWritten = _sink->getBytesWritten();
+        lock.lock();
+        _bytesWritten = bytesWritten;
+        _free.push_back(std::move(chunk));
+        _busy = false;
+        _queueChanged.notify_all();
+      }
+    }
+
+    std::unique_ptr<TraceSink> _sink;
+    size_t _chunkSize;
+    size_t _queueCapacity;
+    size_t _stalls;
+    size_t _bytesWritten;
+
+    std::unique_ptr<Chunk> _current;
+    std::deque<std::unique_ptr<Chunk> > _queue;
+    std::vector<std::unique_ptr<Chunk> > _free;
+    bool _busy;
+    bool _stop;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _queueChanged;
+    std::thread _writer;
+};
+
+#endif /* RNN_TRACESINK_HPP_ */
@@ -0,0 +1,223 @@
+/*
+ * Benchmark.cpp
+ *
+ * Revision: October 2026
+ *
+ * Times update() (full, incremental, single precision, with approximate activation functions and on all hardware
+ * threads), mutate(), run() and operator<< over a sweep of network sizes and connection densities, and writes the
+ * results as JSON.
+ *
+ * Usage: ./benchmark [output_file] [seconds_per_measurement]
+ * The results go to the standard output when no output file is given.
+ */
+
+// Standard libraries
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Local libraries
+#include "RNN_NeuralNetwork.hpp"
+#include "Misc_Random.hpp"
+#include "RNN_Instrumentation.hpp"
+#include "RNN_StaticNetwork.hpp"
+
+typedef NeuralNetwork<> rnn_t;
+typedef NeuralNetwork<BasicNeuron<float, uint32_t>, BasicConnection<float, uint32_t> > rnn_float_t;
+
+// Same parameters as the demo.
+double WGT_MIN = -1.0;
+double WGT_MAX = 1.0;
+double MUT_WGT = 0.05;
+double MUT_BIA = 0.05;
+double MUT_ADD = 0.2;
+size_t NUM_RUN = 50;
+unsigned int SEED = 42;
+
+// Network shape of one benchmark case.
+struct Configuration{
+  size_t inputs;
+  size_t outputs;
+  size_t hidden;
+  double density;
+};
+
+// Timing of one operation on one network.
+struct Measurement{
+  std::string operation;
+  size_t iterations;
+  double nanoseconds;
+};
+
+// Builds a network with the indicated shape.
+// Hidden neurons are added with addNeuron(); random connections are then added between any source
+// and any non-input target until there are density * neurons^2 connections.
+template<typename Network_t>
+Network_t buildNetwork(const Configuration& configuration){
+  generator().seed(SEED);
+  Network_t network(configuration.inputs, configuration.outputs);
+  network.setMinWeight(WGT_MIN);
+  network.setMaxWeight(WGT_MAX);
+  network.setWeightMutRate(MUT_WGT);
+  network.setNeuronMutRate(MUT_BIA);
+  network.setAddNeuronMutRate(MUT_ADD);
+  network.setAddConnectionMutRate(MUT_ADD);
+  for(size_t i = 0; i < configuration.hidden; i++){
+    network.addNeuron();
+  }
+  size_t nbOfNeurons = network.getNbOfNeurons();
+  size_t nbOfConnections = size_t(configuration.density * nbOfNeurons * nbOfNeurons);
+  network.reserve(nbOfNeurons, nbOfConnections);
+  RandomEngine& rng = network.getRandomEngine();
+  while(network.getNbOfConnections() < nbOfConnections){
+    network.addConnection(rng.randIndex(nbOfNeurons), rng.randIndex(configuration.inputs, nbOfNeurons));
+  }
+  network.randomize();
+  return network;
+}
+
+// Returns the time elapsed since the indicated start, in nanoseconds.
+double elapsed(std::chrono::steady_clock::time_point start){
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Times an operation that leaves the network reusable, repeating it for at least the indicated time.
+template<typename Operation>
+Measurement measure(const std::string& name, double seconds, Operation operation){
+  Measurement measurement = {name, 0, 0.0};
+  operation();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  do{
+    operation();
+    measurement.iterations++;
+  }while(elapsed(start) < seconds * 1e9);
+  measurement.nanoseconds = elapsed(start) / measurement.iterations;
+  return measurement;
+}
+
+// Times an operation that changes the network, running it on a fresh copy every time.
+// Only the operation itself is timed.
+template<typename Operation>
+Measurement measureOnCopy(const std::string& name, double seconds, const rnn_t& network, Operation operation){
+  Measurement measurement = {name, 0, 0.0};
+  double total = 0.0;
+  double wall = 0.0;
+  do{
+    std::chrono::steady_clock::time_point copyStart = std::chrono::steady_clock::now();
+    rnn_t copy(network);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    operation(copy);
+    total += elapsed(start);
+    wall += elapsed(copyStart);
+    measurement.iterations++;
+  }while(wall < seconds * 1e9);
+  measurement.nanoseconds = total / measurement.iterations;
+  return measurement;
+}
+
+// Writes the results of one configuration as a JSON object.
+// With instrumentation compiled in, the counters and phase cycles of all its measurements are included.
+void writeResult(std::ostream& output, const Configuration& configuration, rnn_t& network, const std::vector<Measurement>& measurements,
+                 const Instrumentation::Snapshot& numbers){
+  output << "    {\"inputs\": " << configuration.inputs
+         << ", \"outputs\": " << configuration.outputs
+         << ", \"hidden\": " << configuration.hidden
+         << ", \"density\": " << configuration.density
+         << ", \"neurons\": " << network.getNbOfNeurons()
+         << ", \"connections\": " << network.getNbOfConnections()
+         << ",\n     \"operations\": {";
+  for(size_t i = 0; i < measurements.size(); i++){
+    output << (i > 0 ? ", " : "") << "\"" << measurements[i].operation << "\": {\"iterations\": " << measurements[i].iterations
+           << ", \"ns_per_op\": " << measurements[i].nanoseconds << "}";
+  }
+  output << "}";
+  if(Instrumentation::enabled){
+    output << ",\n     \"instrumentation\": {";
+    for(int i = 0; i < Instrumentation::nbCounters; i++){
+      output << "\"" << Instrumentation::getName(Instrumentation::counter_t(i)) << "\": " << numbers.counters[i] << ", ";
+    }
+    for(int i = 0; i < Instrumentation::nbPhases; i++){
+      output << (i > 0 ? ", " : "") << "\"" << Instrumentation::getName(Instrumentation::phase_t(i)) << "_cycles\": " << numbers.cycles[i];
+    }
+    output << "}";
+  }
+  output << "}";
+}
+
+int main(int argc, char* argv[]) {
+
+    std::string outputFileName = argc > 1 ? argv[1] : "";
+    double seconds = argc > 2 ? atof(argv[2]) : 0.05;
+    std::string traceFileName = "benchmark_trace.csv";
+
+    std::vector<Configuration> configurations;
+    size_t sizes[3][2] = {{4, 8}, {16, 32}, {64, 64}};
+    size_t hidden[3] = {0, 100, 1000};
+    double densities[2] = {0.01, 0.1};
+    for(size_t s = 0; s < 3; s++){
+      for(size_t h = 0; h < 3; h++){
+        for(size_t d = 0; d < 2; d++){
+          Configuration configuration = {sizes[s][0], sizes[s][1], hidden[h], densities[d]};
+          configurations.push_back(configuration);
+        }
+      }
+    }
+
+    std::ofstream outputFile;
+    if(outputFileName != "") outputFile.open(outputFileName.c_str());
+    std::ostream& output = outputFileName != "" ? outputFile : std::cout;
+    output.precision(10);
+
+    output << "{\n  \"benchmark\": \"Standard-RNN\",\n";
+    output << "  \"seconds_per_measurement\": " << seconds << ",\n";
+    output << "  \"run_updates\": " << NUM_RUN << ",\n";
+    output << "  \"results\": [\n";
+    for(size_t i = 0; i < configurations.size(); i++){
+      rnn_t network = buildNetwork<rnn_t>(configurations[i]);
+      rnn_float_t floatNetwork = buildNetwork<rnn_float_t>(configurations[i]);
+      Instrumentation::Snapshot start = Instrumentation::snapshot();
+      std::vector<Measurement> measurements;
+      measurements.push_back(measure("update", seconds, [&](){ network.update(); }));
+      network.setIncrementalUpdate(true);
+      measurements.push_back(measure("update_incremental", seconds, [&](){ network.update(); }));
+      network.setIncrementalUpdate(false);
+      network.setActivationPrecision(Activation::polynomial);
+      measurements.push_back(measure("update_polynomial", seconds, [&](){ network.update(); }));
+      network.setActivationPrecision(Activation::table);
+      measurements.push_back(measure("update_table", seconds, [&](){ network.update(); }));
+      network.setActivationPrecision(Activation::exact);
+      network.setThreads(0);
+      measurements.push_back(measure("update_parallel", seconds, [&](){ network.update(); }));
+      network.setThreads(1);
+      measurements.push_back(measure("update_float32", seconds, [&](){ floatNetwork.update(); }));
+      measurements.push_back(measureOnCopy("mutate", seconds, network, [](rnn_t& copy){ copy.mutate(); }));
+      measurements.push_back(measureOnCopy("run", seconds, network, [](rnn_t& copy){ copy.run(NUM_RUN); }));
+      measurements.push_back(measureOnCopy("run_trace", seconds, network, [&](rnn_t& copy){ copy.run(NUM_RUN, traceFileName); }));
+      measurements.push_back(measure("write", seconds, [&](){
+        std::ostringstream stream;
+        stream << network;
+      }));
+      writeResult(output, configurations[i], network, measurements, Instrumentation::snapshot() - start);
+      output << (i + 1 < configurations.size() ? ",\n" : "\n");
+      output.flush();
+    }
+    output << "  ],\n";
+
+    // A small controller frozen into a StaticNetwork.
+    Configuration controller = {4, 8, 4, 0.3};
+    rnn_t network = buildNetwork<rnn_t>(controller);
+    StaticNetwork<4, 8, 4, 128> staticNetwork(network);
+    Measurement dynamicUpdate = measure("update", seconds, [&](){ network.update(); });
+    Measurement staticUpdate = measure("update_static", seconds, [&](){ staticNetwork.update(); });
+    output << "  \"static_network\": {\"neurons\": " << network.getNbOfNeurons() << ", \"connections\": " << network.getNbOfConnections()
+           << ", \"update_ns_per_op\": " << dynamicUpdate.nanoseconds << ", \"update_static_ns_per_op\": " << staticUpdate.nanoseconds << "}\n}\n";
+
+    std::remove(traceFileName.c_str());
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * Codegen.cpp
+ *
+ * Revision: October 2026
+ *
+ * Exports a saved network to a standalone C++ kernel and a harness that checks it against update().
+ *
+ * Usage: ./codegen network_file output_base_name [kernel_name]
+ * The network file is either a binary network file or text written with operator<<.
+ * Writes output_base_name.hpp, output_base_name.cpp and output_base_name_test.cpp (see RNN_CodeGenerator.hpp).
+ * The kernel name defaults to the file name part of output_base_name.
+ */
+
+// Standard libraries
+#include <iostream>
+#include <string>
+
+// Local libraries
+#include "RNN_CodeGenerator.hpp"
+#include "RNN_NeuralNetwork.hpp"
+
+int main(int argc, char* argv[]) {
+
+    if(argc < 3){
+      std::cerr << "Usage: " << argv[0] << " network_file output_base_name [kernel_name]" << std::endl;
+      return 1;
+    }
+    std::string networkFileName = argv[1];
+    std::string baseName = argv[2];
+    std::string name = argc > 3 ? argv[3] : baseName.substr(baseName.find_last_of("/\\") + 1);
+
+    NeuralNetwork<> network;
+    if(!CodeGenerator::load(networkFileName, network)) return 1;
+    if(!CodeGenerator::generate(network, baseName, name, networkFileName)) return 1;
+
+    std::cout << "Wrote " << baseName << ".hpp, " << baseName << ".cpp and " << baseName << "_test.cpp ("
+              << network.getNbOfNeurons() << " neurons, " << network.getNbOfConnections() << " connections)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,664 @@
+/*
+ * Tests.cpp
+ *
+ * Revision: October 2026
+ *
+ * Checks on seeded random networks that the alternative update paths compute exactly what the full update computes:
+ * incremental against full update, threaded against single-threaded update, output-only against full outputs,
+ * reordered against original network, streamed runs, static networks and generated kernels against step by step
+ * updates, a run resumed from a checkpoint against the uninterrupted run, and vectorized against scalar polynomial
+ * activations.
+ * Also checks the mutation rates of mutate(), version reclamation of NetworkHandle, the random streams of new
+ * threads, and that network files and checkpoints round-trip and reject malformed contents.
+ *
+ * Usage: ./tests
+ * Prints every failed check and returns 1 if any failed.
+ */
+
+// Standard libraries
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Local libraries
+#include "RNN_NeuralNetwork.hpp"
+#include "RNN_Activation.hpp"
+#include "Misc_Random.hpp"
+#include "RNN_Checkpoint.hpp"
+#include "RNN_CodeGenerator.hpp"
+#include "RNN_NetworkFile.hpp"
+#include "RNN_NetworkHandle.hpp"
+#include "RNN_StaticNetwork.hpp"
+
+typedef NeuralNetwork<> rnn_t;
+
+// Same parameters as the demo.
+double WGT_MIN = -1.0;
+double WGT_MAX = 1.0;
+double MUT_WGT = 0.05;
+double MUT_BIA = 0.05;
+double MUT_ADD = 0.2;
+size_t NUM_SEEDS = 30;
+
+size_t nbOfFailures = 0;
+
+// Reports a failed check.
+void check(bool passed, const std::string& name, size_t seed){
+  if(passed) return;
+  std::cerr << "FAILED: " << name << " (seed " << seed << ")" << std::endl;
+  nbOfFailures++;
+}
+
+// Builds a random network with the indicated number of hidden neurons and connections, with all activation
+// functions, seeded so that each seed gives the same network and the same mutations.
+rnn_t buildNetwork(size_t seed, size_t inputs, size_t outputs, size_t hidden, size_t connections){
+  generator().seed(seed);
+  rnn_t network(inputs, outputs);
+  network.setMinWeight(WGT_MIN);
+  network.setMaxWeight(WGT_MAX);
+  network.setWeightMutRate(MUT_WGT);
+  network.setNeuronMutRate(MUT_BIA);
+  network.setAddNeuronMutRate(MUT_ADD);
+  network.setAddConnectionMutRate(MUT_ADD);
+  for(size_t i = 0; i < hidden; i++){
+    network.addNeuron();
+  }
+  size_t nbOfNeurons = network.getNbOfNeurons();
+  RandomEngine& rng = network.getRandomEngine();
+  for(size_t i = 0; i < connections; i++){
+    network.addConnection(rng.randIndex(nbOfNeurons), rng.randIndex(inputs, nbOfNeurons));
+  }
+  for(size_t i = 0; i < nbOfNeurons; i++){
+    network.setActivationFunction(i, Neuron::af_t(rng.randIndex(Neuron::nbActivationFunctions)));
+    network.setLambda(i, rng.randDouble(0.5, 2.0));
+  }
+  network.randomize();
+  for(size_t i = 0; i < inputs; i++){
+    network.setValue(i, rng.randDouble(-1.0, 1.0));
+  }
+  return network;
+}
+
+// Returns true if both networks hold the same activation values and incoming potentials.
+bool sameState(rnn_t& first, rnn_t& second){
+  if(first.getNbOfNeurons() != second.getNbOfNeurons()) return false;
+  const rnn_t::plan_t& firstPlan = first.getExecutionPlan();
+  const rnn_t::plan_t& secondPlan = second.getExecutionPlan();
+  for(size_t i = 0; i < first.getNbOfNeurons(); i++){
+    if(firstPlan.getValue(i) != secondPlan.getValue(i) || firstPlan.getIncoming(i) != secondPlan.getIncoming(i)) return false;
+  }
+  return true;
+}
+
+// Returns true if both networks hold the same output values.
+bool sameOutputs(rnn_t& first, rnn_t& second){
+  for(size_t i = 0; i < first.getOutputs(); i++){
+    if(first.getOutputValue(i) != second.getOutputValue(i)) return false;
+  }
+  return true;
+}
+
+// Returns the path of a scratch file with the indicated name in the temporary directory.
+std::string temporaryFile(const std::string& name){
+  return (std::filesystem::temp_directory_path() / ("rnn_tests_" + name)).string();
+}
+
+// Writes the supplied bytes to the indicated file.
+void writeFile(const std::string& fileName, const std::string& contents){
+  std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(contents.data(), contents.size());
+}
+
+// Reads the indicated file.
+std::string readFile(const std::string& fileName){
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+// Returns the complete state of a network, as written to checkpoints.
+std::string stateOf(rnn_t& network){
+  std::ostringstream output;
+  network.writeState(output);
+  return output.str();
+}
+
+// The incremental update with epsilon = 0 matches the full update, through mutations.
+// The network is sparse enough for changes to reach few neurons, so that updates take the incremental path.
+void testIncrementalUpdate(size_t seed){
+  rnn_t full = buildNetwork(seed, 3, 2, 300, 450);
+  rnn_t incremental = full;
+  incremental.setIncrementalUpdate(true);
+  bool same = true;
+  for(size_t round = 0; round < 20 && same; round++){
+    for(size_t step = 0; step < 10 && same; step++){
+      // A changing input keeps the incremental update from settling on a fixed point.
+      full.setValue(0, std::sin(double(round * 10 + step)));
+      incremental.setValue(0, std::sin(double(round * 10 + step)));
+      full.update();
+      incremental.update();
+      same = sameState(full, incremental);
+    }
+    full.mutate();
+    incremental.mutate();
+  }
+  check(same, "incremental update matches full update", seed);
+}
+
+// The threaded update matches the single-threaded update. The network is large enough for several threads.
+void testThreadedUpdate(size_t seed){
+  rnn_t single = buildNetwork(seed, 8, 4, 8000, 60000);
+  rnn_t threaded = single;
+  threaded.setThreads(4);
+  bool same = true;
+  for(size_t step = 0; step < 5 && same; step++){
+    single.update();
+    threaded.update();
+    same = sameState(single, threaded);
+  }
+  check(same, "threaded update matches single-threaded update", seed);
+}
+
+// The output-only update gives the same outputs as the full update while run() mutates both networks.
+// With an add connection mutation rate, pruning is suspended; without one, pruning is checked to take place.
+void testOutputOnly(size_t seed, bool addConnections){
+  rnn_t full = buildNetwork(seed, 3, 2, 60, 90);
+  if(!addConnections) full.setAddConnectionMutRate(0.0);
+  rnn_t pruned = full;
+  pruned.setOutputOnly(true);
+  bool same = true;
+  size_t nbOfLive = pruned.getNbOfLiveNeurons();
+  for(size_t step = 0; step < 200 && same; step++){
+    full.run(1);
+    pruned.run(1);
+    same = sameOutputs(full, pruned);
+    nbOfLive = std::min(nbOfLive, pruned.getNbOfLiveNeurons());
+  }
+  check(same, "output-only update matches full outputs", seed);
+  if(!addConnections) check(nbOfLive < pruned.getNbOfNeurons(), "output-only update prunes neurons", seed);
+}
+
+// A run resumed from a checkpoint continues exactly as the uninterrupted run.
+void testCheckpoint(size_t seed, bool incremental, bool outputOnly){
+  std::string fileName = temporaryFile("checkpoint.ckpt");
+  rnn_t network = buildNetwork(seed, 3, 2, 40, 160);
+  network.setIncrementalUpdate(incremental);
+  network.setOutputOnly(outputOnly);
+  network.run(100);
+  rnn_t resumed(1, 1);
+  bool loaded = CheckpointFile::save(fileName, network) && CheckpointFile::load(fileName, resumed);
+  std::remove(fileName.c_str());
+  network.run(200);
+  resumed.run(200);
+  check(loaded && stateOf(network) == stateOf(resumed), "resumed run matches uninterrupted run", seed);
+}
+
+// Checkpoints whose state does not describe a consistent network are rejected, leaving the network unchanged.
+void testMalformedCheckpoint(size_t seed){
+  std::string fileName = temporaryFile("malformed.ckpt");
+  rnn_t network = buildNetwork(seed, 3, 2, 40, 160);
+  network.run(10);
+  rnn_t loaded = buildNetwork(seed + 1, 2, 2, 5, 10);
+  std::string expected = stateOf(loaded);
+  CheckpointFile::save(fileName, network);
+  // The number of inputs follows the magic, the version and the sizes of the scalar and index types.
+  std::string contents = readFile(fileName);
+  uint64_t nbOfInputs = 1000;
+  std::memcpy(&contents[24], &nbOfInputs, sizeof(nbOfInputs));
+  writeFile(fileName, contents);
+  check(!CheckpointFile::load(fileName, loaded), "checkpoint with too many inputs is rejected", seed);
+  // A connection killed or redirected behind the back of the adjacency lists.
+  for(size_t variant = 0; variant < 2; variant++){
+    rnn_t broken = network;
+    size_t connectionIndex = seed % broken.getNbOfConnectionSlots();
+    rnn_t::connections_t& connections = broken.getConnections();
+    if(variant == 0) connections.write(connectionIndex).kill();
+    else connections.write(connectionIndex) = Connection((connections[connectionIndex].getSource() + 1) % broken.getNbOfNeurons(), connections[connectionIndex].getTarget(), 0.5);
+    CheckpointFile::save(fileName, broken);
+    check(!CheckpointFile::load(fileName, loaded), "checkpoint with inconsistent adjacency lists is rejected", seed);
+  }
+  writeFile(fileName, readFile(fileName).substr(0, 100));
+  check(!CheckpointFile::load(fileName, loaded), "truncated checkpoint is rejected", seed);
+  check(stateOf(loaded) == expected, "rejected checkpoints leave the network unchanged", seed);
+  std::remove(fileName.c_str());
+}
+
+// A network saved to a binary network file loads back with the same structure and computes the same outputs,
+// and malformed files are rejected.
+void testNetworkFile(size_t seed){
+  std::string fileName = temporaryFile("network.rnnb");
+  rnn_t network = buildNetwork(seed, 3, 2, 40, 160);
+  network.removeConnection(5);
+  network.reset();
+  rnn_t loaded(1, 1);
+  bool saved = NetworkFile::save(fileName, network);
+  check(saved && NetworkFile::load(fileName, loaded), "network file loads", seed);
+  std::ostringstream text, loadedText;
+  text << network;
+  loadedText << loaded;
+  check(loaded.getInputs() == network.getInputs() && loaded.getOutputs() == network.getOutputs() && text.str() == loadedText.str(), "network file keeps structure", seed);
+  for(size_t step = 0; step < 20; step++){
+    network.update();
+    loaded.update();
+  }
+  check(sameState(network, loaded), "network file keeps activation functions and lambdas", seed);
+
+  std::string contents = readFile(fileName);
+  NetworkFileHeader header;
+  std::memcpy(&header, contents.data(), sizeof(header));
+  NetworkFileHeader malformed = header;
+  malformed.nbOfInputs = 1000;
+  writeFile(fileName, std::string(reinterpret_cast<const char*>(&malformed), sizeof(malformed)) + contents.substr(sizeof(header)));
+  check(!NetworkFile::load(fileName, loaded), "network file with too many inputs is rejected", seed);
+  // Counts whose sizes wrap around to the size of the header alone.
+  malformed = header;
+  malformed.nbOfNeurons = uint64_t(1) << 60;
+  malformed.nbOfConnections = uint64_t(5) << 57;
+  writeFile(fileName, std::string(reinterpret_cast<const char*>(&malformed), sizeof(malformed)));
+  check(!NetworkFile::load(fileName, loaded), "network file with overflowing counts is rejected", seed);
+  writeFile(fileName, contents.substr(0, contents.size() - 1));
+  check(!NetworkFile::load(fileName, loaded), "truncated network file is rejected", seed);
+  std::string badActivation = contents;
+  badActivation[sizeof(header) + 2 * header.nbOfNeurons * sizeof(double)] = char(Neuron::nbActivationFunctions);
+  writeFile(fileName, badActivation);
+  check(!NetworkFile::load(fileName, loaded), "network file with an invalid activation function is rejected", seed);
+  std::remove(fileName.c_str());
+}
+
+// mutate() selects every neuron and every live connection independently at its mutation rate, although it skips
+// over the unselected ones: none at rate 0, all at rate 1, and about rate times their number in between.
+void testMutationRates(size_t seed){
+  rnn_t network = buildNetwork(seed, 4, 4, 2000, 8000);
+  for(size_t i = 0; i < 100; i++){
+    network.removeConnection(i * 7);
+  }
+  // Wide weight bounds keep mutated values from being clamped to the value they had.
+  network.setMinWeight(-100.0);
+  network.setMaxWeight(100.0);
+  network.setAddNeuronMutRate(0.0);
+  network.setAddConnectionMutRate(0.0);
+  size_t nbOfNeurons = network.getNbOfNeurons();
+  size_t nbOfSlots = network.getNbOfConnectionSlots();
+  size_t rounds = 50;
+  double rates[3] = {0.0, 0.01, 1.0};
+  for(size_t r = 0; r < 3; r++){
+    rnn_t mutated = network;
+    mutated.setNeuronMutRate(rates[r]);
+    mutated.setWeightMutRate(rates[r]);
+    size_t nbOfBiases = 0;
+    size_t nbOfWeights = 0;
+    bool deadChanged = false;
+    for(size_t round = 0; round < rounds; round++){
+      std::vector<double> biases(nbOfNeurons), weights(nbOfSlots);
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        biases[i] = mutated.getBias(i);
+      }
+      for(size_t i = 0; i < nbOfSlots; i++){
+        weights[i] = mutated.getWeight(i);
+      }
+      mutated.mutate();
+      for(size_t i = 0; i < nbOfNeurons; i++){
+        if(mutated.getBias(i) != biases[i]) nbOfBiases++;
+      }
+      for(size_t i = 0; i < nbOfSlots; i++){
+        if(mutated.getWeight(i) == weights[i]) continue;
+        if(mutated.isAlive(i)) nbOfWeights++;
+        else deadChanged = true;
+      }
+    }
+    double expectedBiases = rates[r] * double(rounds * nbOfNeurons);
+    double expectedWeights = rates[r] * double(rounds * network.getNbOfConnections());
+    std::string rate = " at rate " + std::to_string(rates[r]);
+    check(std::fabs(double(nbOfBiases) - expectedBiases) <= 0.15 * expectedBiases, "number of bias mutations" + rate, seed);
+    check(std::fabs(double(nbOfWeights) - expectedWeights) <= 0.15 * expectedWeights, "number of weight mutations" + rate, seed);
+    check(!deadChanged, "dead connections are not mutated" + rate, seed);
+  }
+}
+
+// reorderNeurons() returns a permutation that keeps the input and output neurons in place and moves every neuron
+// with its state, and the reordered network computes the same values as the original one.
+void testReordering(size_t seed){
+  rnn_t network = buildNetwork(seed, 3, 2, 200, 600);
+  for(size_t i = 0; i < 20; i++){
+    network.mutate();
+  }
+  rnn_t reordered = network;
+  rnn_t::reordering_t reordering = seed % 2 == 0 ? rnn_t::breadthFirst : rnn_t::reverseCuthillMcKee;
+  std::vector<size_t> permutation = reordered.reorderNeurons(reordering);
+  size_t nbOfNeurons = network.getNbOfNeurons();
+  std::vector<char> taken(nbOfNeurons, 0);
+  bool valid = permutation.size() == nbOfNeurons && reordered.getNbOfNeurons() == nbOfNeurons;
+  for(size_t i = 0; i < permutation.size() && valid; i++){
+    valid = permutation[i] < nbOfNeurons && !taken[permutation[i]] && (i >= 5 || permutation[i] == i);
+    if(valid) taken[permutation[i]] = 1;
+  }
+  check(valid, "reordering gives a permutation that keeps inputs and outputs in place", seed);
+  if(!valid) return;
+  bool same = true;
+  for(size_t step = 0; step <= 20 && same; step++){
+    for(size_t i = 0; i < nbOfNeurons; i++){
+      if(network.getValue(i) != reordered.getValue(permutation[i]) || network.getBias(i) != reordered.getBias(permutation[i])) same = false;
+    }
+    network.update();
+    reordered.update();
+  }
+  check(same, "reordered network matches the original one", seed);
+}
+
+// run(inputs, outputs, steps) gives the outputs of setting the inputs and updating step by step, and the source
+// form stops when its source does.
+void testStreaming(size_t seed){
+  rnn_t streamed = buildNetwork(seed, 3, 2, 100, 400);
+  rnn_t stepped = streamed;
+  rnn_t sourced = streamed;
+  size_t steps = 50;
+  RandomEngine rng(seed);
+  std::vector<double> inputs(steps * 3), outputs(steps * 2), sourcedOutputs(steps * 2, 0.0);
+  for(size_t i = 0; i < inputs.size(); i++){
+    inputs[i] = rng.randDouble(-1.0, 1.0);
+  }
+  streamed.run(inputs.data(), outputs.data(), steps);
+  bool same = true;
+  for(size_t step = 0; step < steps; step++){
+    for(size_t i = 0; i < 3; i++){
+      stepped.setValue(i, inputs[step * 3 + i]);
+    }
+    stepped.update();
+    for(size_t i = 0; i < 2; i++){
+      if(outputs[step * 2 + i] != stepped.getOutputValue(i)) same = false;
+    }
+  }
+  check(same && sameState(streamed, stepped), "streamed run matches step by step updates", seed);
+  size_t nbOfSteps = sourced.run([&](size_t step, double* row){
+    if(step == 30) return false;
+    std::copy(inputs.begin() + step * 3, inputs.begin() + step * 3 + 3, row);
+    return true;
+  }, sourcedOutputs.data(), steps);
+  check(nbOfSteps == 30 && std::equal(sourcedOutputs.begin(), sourcedOutputs.begin() + 60, outputs.begin()) &&
+        std::all_of(sourcedOutputs.begin() + 60, sourcedOutputs.end(), [](double value){ return value == 0.0; }),
+        "sourced run matches streamed run until the source ends", seed);
+}
+
+// A handle whose epochs can be announced by hand, standing in for a reader caught copying a version.
+class TestHandle: public NetworkHandle<rnn_t>{
+  public:
+    using NetworkHandle<rnn_t>::NetworkHandle;
+
+    // Makes the indicated slot announce the current epoch.
+    void announce(size_t slot){
+      _slots[slot].epoch.store(_epoch.load());
+    }
+
+    // Makes the indicated slot quiescent.
+    void quiesce(size_t slot){
+      _slots[slot].epoch.store(quiescent);
+    }
+};
+
+// A handle deletes replaced versions as soon as no reader can still be copying them, and keeps them while one can.
+// A refreshed reader switches to the newest version and carries its activation state over.
+void testNetworkHandle(size_t seed){
+  rnn_t network = buildNetwork(seed, 3, 2, 50, 200);
+  rnn_t improved = network;
+  improved.mutate();
+  TestHandle handle(network, 4);
+  NetworkHandle<rnn_t>::Reader reader(handle);
+  for(size_t step = 0; step < 5; step++){
+    reader.getNetwork().update();
+  }
+  handle.publish(improved);
+  check(handle.getNbOfRetired() == 0, "replaced version is deleted when no reader copies it", seed);
+  handle.announce(1);
+  handle.publish(network);
+  handle.publish(improved);
+  check(handle.getNbOfRetired() == 2, "replaced versions are kept while a reader may copy them", seed);
+  handle.quiesce(1);
+  handle.publish(network);
+  check(handle.getNbOfRetired() == 0, "replaced versions are deleted once the reader is done", seed);
+  std::vector<double> values(network.getNbOfNeurons());
+  for(size_t i = 0; i < values.size(); i++){
+    values[i] = reader.getNetwork().getValue(i);
+  }
+  bool refreshed = reader.refresh();
+  bool carried = reader.getNetwork().getNbOfNeurons() == values.size();
+  for(size_t i = 0; i < values.size() && carried; i++){
+    carried = reader.getNetwork().getValue(i) == values[i];
+  }
+  check(refreshed && reader.getVersion() == handle.getVersion() && !reader.refresh() && carried, "reader switches to the newest version with its state", seed);
+}
+
+// Builds a sigmoid network with one hidden neuron that no output depends on, which the output-only update prunes.
+rnn_t buildPrunedNetwork(size_t seed){
+  rnn_t network = buildNetwork(seed, 3, 2, 40, 160);
+  network.addNeuron();
+  network.addConnection(0, network.getNbOfNeurons() - 1, 0.5);
+  for(size_t i = 0; i < network.getNbOfNeurons(); i++){
+    network.setActivationFunction(i, Neuron::sigmoid);
+  }
+  network.setAddConnectionMutRate(0.0);
+  network.setOutputOnly(true);
+  return network;
+}
+
+// A static network refuses a network whose execution plan leaves pruned neurons out, and once pruning is off it
+// computes the same values as the network.
+void testStaticNetwork(size_t seed){
+  rnn_t network = buildPrunedNetwork(seed);
+  StaticNetwork<3, 2, 41, 200> controller;
+  check(!controller.load(network), "static network rejects a pruned plan", seed);
+  network.setOutputOnly(false);
+  bool loaded = controller.load(network);
+  bool same = loaded;
+  for(size_t step = 0; step < 20 && same; step++){
+    network.update();
+    controller.update();
+    for(size_t i = 0; i < network.getNbOfNeurons(); i++){
+      if(controller.getValue(i) != network.getValue(i)) same = false;
+    }
+  }
+  check(same, "static network matches update()", seed);
+}
+
+// Reads a literal written by the code generator: a hexadecimal floating-point number, possibly in parentheses,
+// NAN or INFINITY.
+double parseLiteral(const char*& text){
+  bool parenthesized = *text == '(';
+  if(parenthesized) text++;
+  char* end;
+  double value = std::strtod(text, &end);
+  text = end;
+  if(parenthesized && *text == ')') text++;
+  return value;
+}
+
+// The kernel written by the code generator computes the update step of the network: its step function, evaluated
+// line by line, gives the values of update() exactly. Invalid kernel names are rejected.
+void testCodeGenerator(size_t seed){
+  std::string baseName = temporaryFile("kernel");
+  rnn_t network = buildNetwork(seed, 3, 2, 40, 160);
+  network.removeConnection(3);
+  check(!CodeGenerator::generate(network, baseName, "9kernel"), "code generator rejects an invalid kernel name", seed);
+  rnn_t pruned = buildPrunedNetwork(seed);
+  check(!CodeGenerator::generate(pruned, baseName, "kernel"), "code generator rejects a pruned plan", seed);
+  bool generated = CodeGenerator::generate(network, baseName, "kernel");
+  std::string header = readFile(baseName + ".hpp");
+  std::istringstream source(readFile(baseName + ".cpp"));
+  std::remove((baseName + ".hpp").c_str());
+  std::remove((baseName + ".cpp").c_str());
+  std::remove((baseName + "_test.cpp").c_str());
+  size_t nbOfNeurons = network.getNbOfNeurons();
+  check(generated && header.find("#define KERNEL_NB_NEURONS " + std::to_string(nbOfNeurons) + "\n") != std::string::npos,
+        "code generator writes the kernel interface", seed);
+  // Every incoming potential is a list of (source, weight) terms; every activation is a function of the potential
+  // plus a bias, with a lambda for the sigmoid.
+  std::vector<std::vector<std::pair<size_t, double> > > terms(nbOfNeurons);
+  std::vector<int> functions(nbOfNeurons, -1);
+  std::vector<double> biases(nbOfNeurons), lambdas(nbOfNeurons);
+  std::string line;
+  bool parsed = true;
+  while(std::getline(source, line)){
+    const char* text = line.c_str();
+    size_t index = 0;
+    int length = 0;
+    if(std::sscanf(text, "  x[%zu] = 0.0%n", &index, &length) == 1 && length > 0){
+      text += length;
+      if(index >= nbOfNeurons){
+        parsed = false;
+        continue;
+      }
+      size_t sourceIndex = 0;
+      while(std::sscanf(text, " + v[%zu] * %n", &sourceIndex, &length) == 1){
+        text += length;
+        terms[index].push_back(std::make_pair(sourceIndex, parseLiteral(text)));
+      }
+      parsed = parsed && *text == ';';
+    }
+    else if(std::sscanf(text, "  state->values[%zu] = %n", &index, &length) == 1){
+      text += length;
+      if(index >= nbOfNeurons){
+        parsed = false;
+        continue;
+      }
+      static const char* prefixes[4] = {"linear(x[", "std::sin(x[", "gaussian(x[", "std::tanh((x["};
+      for(int f = 0; f < 4; f++){
+        if(std::strncmp(text, prefixes[f], std::strlen(prefixes[f])) == 0) functions[index] = f;
+      }
+      const char* plus = std::strstr(text, "] + ");
+      if(functions[index] < 0 || !plus){
+        parsed = false;
+        continue;
+      }
+      text = plus + 4;
+      biases[index] = parseLiteral(text);
+      if(functions[index] == Neuron::sigmoid){
+        parsed = parsed && std::strncmp(text, ") * ", 4) == 0;
+        text += 4;
+        lambdas[index] = parseLiteral(text);
+      }
+    }
+  }
+  parsed = parsed && std::find(functions.begin(), functions.end(), -1) == functions.end();
+  check(parsed, "code generator writes a step for every neuron", seed);
+  if(!parsed) return;
+  std::vector<double> values(nbOfNeurons), potentials(nbOfNeurons);
+  for(size_t i = 0; i < nbOfNeurons; i++){
+    values[i] = network.getValue(i);
+  }
+  bool same = true;
+  for(size_t step = 0; step < 20 && same; step++){
+    for(size_t i = 0; i < nbOfNeurons; i++){
+      potentials[i] = 0.0;
+      for(size_t j = 0; j < terms[i].size(); j++){
+        potentials[i] = potentials[i] + values[terms[i][j].first] * terms[i][j].second;
+      }
+    }
+    for(size_t i = 0; i < nbOfNeurons; i++){
+      double x = potentials[i] + biases[i];
+      switch(functions[i]){
+        case Neuron::linear: values[i] = x > 1.0 ? 1.0 : (x < -1.0 ? -1.0 : x); break;
+        case Neuron::sine: values[i] = std::sin(x); break;
+        case Neuron::gaussian: values[i] = std::exp(-x*x) * 2.0 - 1.0; break;
+        default: values[i] = std::tanh(x * lambdas[i]); break;
+      }
+    }
+    network.update();
+    for(size_t i = 0; i < nbOfNeurons; i++){
+      if(values[i] != network.getValue(i)) same = false;
+    }
+  }
+  check(same, "generated kernel matches update()", seed);
+}
+
+// Threads that never seed their generator draw different numbers, and seeded ones repeat each other.
+void testThreadGenerators(){
+  uint64_t draws[4], seededDraws[4];
+  for(size_t i = 0; i < 4; i++){
+    std::thread thread([&, i](){
+      draws[i] = generator()();
+      seed(7);
+      seededDraws[i] = generator()();
+    });
+    thread.join();
+  }
+  bool distinct = true;
+  for(size_t i = 0; i < 4; i++){
+    for(size_t j = 0; j < i; j++){
+      if(draws[i] == draws[j]) distinct = false;
+    }
+  }
+  check(distinct, "threads start from different random streams", 0);
+  check(std::count(seededDraws, seededDraws + 4, seededDraws[0]) == 4, "threads seeded alike draw alike", 0);
+}
+
+// The vectorized polynomial activations give, lane by lane, what the scalar polynomials of FastMath give,
+// including for the remainder after the last full vector, NaN and arguments far outside the usual range.
+template<typename Scalar_t>
+void testPolynomialActivations(size_t seed){
+  RandomEngine rng(seed);
+  size_t n = 1000 + seed;
+  std::vector<Scalar_t> incoming(n), bias(n), lambda(n), value(n);
+  for(size_t i = 0; i < n; i++){
+    incoming[i] = Scalar_t(rng.randDouble(-1.0, 1.0) * std::pow(10.0, double(i % 5)));
+    bias[i] = Scalar_t(rng.randDouble(-1.0, 1.0));
+    lambda[i] = Scalar_t(rng.randDouble(0.5, 2.0));
+  }
+  incoming[0] = std::numeric_limits<Scalar_t>::quiet_NaN();
+  incoming[1] = std::numeric_limits<Scalar_t>::infinity();
+  incoming[2] = -std::numeric_limits<Scalar_t>::infinity();
+  for(int activation = Neuron::sine; activation <= Neuron::sigmoid; activation++){
+    Activation::apply(Neuron::af_t(activation), Activation::polynomial, incoming.data(), bias.data(), lambda.data(), value.data(), n);
+    bool same = true;
+    for(size_t i = 0; i < n; i++){
+      Scalar_t x = incoming[i] + bias[i];
+      Scalar_t expected = activation == Neuron::sine ? FastMath::sin(x) :
+                          activation == Neuron::gaussian ? FastMath::exp(-x*x) * Scalar_t(2) - Scalar_t(1) : FastMath::tanh(x * lambda[i]);
+      if(expected != value[i] && !(std::isnan(expected) && std::isnan(value[i]))) same = false;
+    }
+    check(same, std::string("vectorized polynomial ") + Activation::getName(Neuron::af_t(activation)) + " matches the scalar one", seed);
+  }
+}
+
+int main() {
+
+    for(size_t seed = 0; seed < NUM_SEEDS; seed++){
+      testIncrementalUpdate(seed);
+      testOutputOnly(seed, true);
+      testOutputOnly(seed, false);
+      testCheckpoint(seed, false, false);
+      testCheckpoint(seed, true, false);
+      testCheckpoint(seed, false, true);
+      testMalformedCheckpoint(seed);
+      testNetworkFile(seed);
+      testPolynomialActivations<double>(seed);
+      testPolynomialActivations<float>(seed);
+      testMutationRates(seed);
+      testReordering(seed);
+      testStreaming(seed);
+      testNetworkHandle(seed);
+      testCodeGenerator(seed);
+      testStaticNetwork(seed);
+    }
+    for(size_t seed = 0; seed < 3; seed++){
+      testThreadedUpdate(seed);
+    }
+    testThreadGenerators();
+
+    if(nbOfFailures > 0){
+      std::cerr << nbOfFailures << " checks failed" << std::endl;
+      return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}